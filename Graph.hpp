@@ -11,9 +11,26 @@
 #include <iostream>  // std::cout
 #include <algorithm> // std::swap
 #include <stdexcept>
+#include <new>       // std::bad_alloc
 #include <string>
 #include <iterator>  // std::forward_iterator_tag
 #include <cstddef>   // std::ptrdiff_t
+#include <cstring>   // std::memcmp
+#include <vector>
+#include <set>       // std::set
+#include <utility>   // std::pair
+#include <cmath>     // std::fabs
+#include <climits>   // INT_MAX
+#include <thread>
+#include <system_error> // std::system_error
+#include <sstream>   // std::ostringstream
+#include <cerrno>
+// Scrittura su file descriptor solo dove è disponibile l'API POSIX
+#if defined(__unix__) || defined(__APPLE__)
+#define GRAPH_FD_OUTPUT
+#include <unistd.h>  // write
+#endif
+#include <chrono>
 
 /**
     Classe eccezione custom che deriva da std::logic_error
@@ -35,6 +52,340 @@ public:
     }
 };
 
+/**
+    Operazioni del grafo di cui vengono misurati numero di chiamate e tempo.
+ 
+    @brief Operazioni misurate dalle statistiche del grafo
+ */
+enum graph_op {
+    OP_ADD_NODE,
+    OP_REMOVE_NODE,
+    OP_ADD_EDGE,
+    OP_REMOVE_EDGE,
+    OP_HAS_EDGE,
+    OP_EXISTS,
+    OP_COPY,
+    OP_APPLY_PATCH,
+    OP_COUNT
+};
+
+/**
+    Istantanea dei contatori di un grafo. I contatori sono aggiornati solo
+    dai grafi che usano la politica collect_stats (Graph<T, E, collect_stats>);
+    con la politica di default no_stats restano a zero e non hanno alcun
+    costo. I contatori non sono protetti da accessi concorrenti.
+ 
+    @brief Statistiche delle operazioni di un grafo
+ */
+struct graph_stats {
+    unsigned long long calls[OP_COUNT];  ///< numero di chiamate per operazione
+    unsigned long long nanos[OP_COUNT];  ///< tempo totale per operazione (ns)
+    unsigned long long eql_calls;        ///< chiamate al funtore di uguaglianza
+    unsigned long long allocations;      ///< allocazioni di array sullo heap
+    unsigned long long bytes_allocated;  ///< byte allocati
+    unsigned long long bytes_copied;     ///< byte copiati tra array
+    unsigned long long exceptions;       ///< eccezioni custom lanciate
+    
+    graph_stats() : eql_calls(0), allocations(0), bytes_allocated(0), bytes_copied(0), exceptions(0) {
+        for (int i = 0; i < OP_COUNT; ++i) {
+            calls[i] = 0;
+            nanos[i] = 0;
+        }
+    }
+    
+    /**
+        Metodo per stampare le statistiche su uno stream.
+     
+        @brief Metodo per stampare le statistiche.
+     
+        @param os stream di destinazione.
+     */
+    void dump(std::ostream &os) const {
+        static const char *names[OP_COUNT] = {
+            "addNode", "removeNode", "addEdge", "removeEdge",
+            "hasEdge", "exists", "copy", "applyPatch"
+        };
+        for (int i = 0; i < OP_COUNT; ++i) {
+            os << names[i] << ": " << calls[i] << " chiamate, " << nanos[i] << " ns\n";
+        }
+        os << "uguaglianze: " << eql_calls << "\n";
+        os << "allocazioni: " << allocations << " (" << bytes_allocated << " byte)\n";
+        os << "byte copiati: " << bytes_copied << "\n";
+        os << "eccezioni: " << exceptions << "\n";
+    }
+};
+
+/**
+    Politica di statistiche di default di Graph: non ha membri e tutte le
+    operazioni sono vuote, quindi non aumenta la dimensione del grafo e non
+    ha alcun costo a tempo di esecuzione.
+ 
+    @brief Politica senza statistiche
+ */
+struct no_stats {
+    enum { enabled = 0 };
+    
+    // Timer vuoto
+    struct timer {
+        timer(const no_stats &, graph_op) {}
+    };
+    
+    void stats_add(unsigned long long graph_stats::*, unsigned long long) const {}
+    void stats_merge(const no_stats &) const {}
+    graph_stats stats_get() const {
+        return graph_stats();
+    }
+    void stats_reset() {}
+};
+
+/**
+    Politica che raccoglie le statistiche di ogni grafo che la usa
+    (Graph<T, E, collect_stats>), indipendentemente dagli altri grafi del
+    programma.
+ 
+    @brief Politica con raccolta delle statistiche
+ */
+class collect_stats {
+    mutable graph_stats _data;
+    
+public:
+    enum { enabled = 1 };
+    
+    /**
+        Timer RAII che aggiunge una chiamata e il tempo trascorso all'operazione
+        indicata, anche se l'operazione termina con un'eccezione.
+     
+        @brief Timer delle operazioni del grafo
+     */
+    class timer {
+        graph_stats &_stats;
+        graph_op _op;
+        std::chrono::steady_clock::time_point _start;
+    public:
+        timer(const collect_stats &s, graph_op op) : _stats(s._data), _op(op), _start(std::chrono::steady_clock::now()) {}
+        
+        ~timer() {
+            ++_stats.calls[_op];
+            _stats.nanos[_op] += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _start).count();
+        }
+    };
+    
+    void stats_add(unsigned long long graph_stats::*field, unsigned long long value) const {
+        _data.*field += value;
+    }
+    
+    // Somma ai contatori quelli di other (ad esempio di un grafo temporaneo)
+    void stats_merge(const collect_stats &other) const {
+        for (int i = 0; i < OP_COUNT; ++i) {
+            _data.calls[i] += other._data.calls[i];
+            _data.nanos[i] += other._data.nanos[i];
+        }
+        _data.eql_calls += other._data.eql_calls;
+        _data.allocations += other._data.allocations;
+        _data.bytes_allocated += other._data.bytes_allocated;
+        _data.bytes_copied += other._data.bytes_copied;
+        _data.exceptions += other._data.exceptions;
+    }
+    
+    graph_stats stats_get() const {
+        return _data;
+    }
+    
+    void stats_reset() {
+        _data = graph_stats();
+    }
+};
+
+/**
+    Destinazione di output per gli esportatori del grafo: uno stream
+    oppure, sui sistemi POSIX (macro GRAPH_FD_OUTPUT), un file descriptor.
+    È costruibile implicitamente solo da uno stream, quindi i metodi di
+    esportazione accettano std::cout, mentre un descrittore va indicato
+    esplicitamente, ad esempio writeMatrix(graph_output(fd)).
+ 
+    @brief Destinazione (stream o file descriptor) per l'esportazione
+ */
+class graph_output {
+    std::ostream *_os;  // Stream di destinazione, nullptr se si usa _fd
+    int _fd;            // File descriptor di destinazione, -1 se si usa _os
+    
+    friend class graph_writer;
+public:
+    graph_output(std::ostream &os) : _os(&os), _fd(-1) {}
+#ifdef GRAPH_FD_OUTPUT
+    explicit graph_output(int fd) : _os(nullptr), _fd(fd) {}
+#endif
+};
+
+/**
+    Scrittore bufferizzato verso una graph_output: accumula i caratteri in
+    un buffer di dimensione fissa e li scrive a blocchi, senza passare per
+    la formattazione degli stream cella per cella.
+ 
+    @brief Scrittore bufferizzato per l'esportazione del grafo
+ */
+class graph_writer {
+    graph_output _out;
+    char _buf[1 << 16];
+    unsigned int _len;
+    
+    graph_writer(const graph_writer &other);            // non copiabile
+    graph_writer &operator=(const graph_writer &other); // non assegnabile
+    
+public:
+    enum { CAPACITY = 1 << 16 };  // Dimensione del buffer in byte
+    
+    explicit graph_writer(graph_output out) : _out(out), _len(0) {}
+    
+    /**
+        Metodo per scrivere il contenuto del buffer sulla destinazione.
+     
+        @brief Metodo per svuotare il buffer.
+     
+        @throw eccezione custom se la scrittura fallisce
+     */
+    void flush() {
+        if (_out._os != nullptr) {
+            _out._os->write(_buf, _len);
+            if (!*_out._os) {
+                throw customException("Valore non valido!", 988);
+            }
+        } else {
+#ifdef GRAPH_FD_OUTPUT
+            unsigned int done = 0;
+            while (done < _len) {
+                ssize_t w = ::write(_out._fd, _buf + done, _len - done);
+                if (w < 0 && errno == EINTR)
+                    continue;
+                if (w <= 0) {
+                    throw customException("Valore non valido!", 988);
+                }
+                done += w;
+            }
+#endif
+        }
+        _len = 0;
+    }
+    
+    // Garantisce almeno n byte liberi nel buffer (n <= CAPACITY)
+    char *reserve(unsigned int n) {
+        if (CAPACITY - _len < n)
+            flush();
+        return _buf + _len;
+    }
+    
+    // Avanza la fine del buffer dopo una scrittura diretta di n byte
+    void commit(unsigned int n) {
+        _len += n;
+    }
+    
+    void put(char c) {
+        *reserve(1) = c;
+        ++_len;
+    }
+    
+    void write(const char *s, unsigned int n) {
+        while (n > 0) {
+            unsigned int chunk = n < (unsigned int)CAPACITY ? n : (unsigned int)CAPACITY;
+            std::memcpy(reserve(chunk), s, chunk);
+            _len += chunk;
+            s += chunk;
+            n -= chunk;
+        }
+    }
+    
+    void write(const std::string &s) {
+        write(s.data(), s.size());
+    }
+    
+    // Scrive un intero non negativo in decimale
+    void write_uint(unsigned long long v) {
+        char tmp[20];
+        int k = 0;
+        do {
+            tmp[k++] = '0' + (v % 10);
+            v /= 10;
+        } while (v != 0);
+        char *p = reserve(k);
+        for (int i = 0; i < k; ++i)
+            p[i] = tmp[k - 1 - i];
+        _len += k;
+    }
+    
+    // Scrive un intero non negativo in formato varint (7 bit per byte)
+    void write_varint(unsigned long long v) {
+        char *p = reserve(10);
+        int k = 0;
+        while (v >= 0x80) {
+            p[k++] = (char)((v & 0x7f) | 0x80);
+            v >>= 7;
+        }
+        p[k++] = (char)v;
+        _len += k;
+    }
+};
+
+/**
+    Operazioni sui bit delle parole da 64 bit, condivise dai kernel a bit
+    di Graph e dal grafo su disco.
+ 
+    @brief Operazioni sui bit di una parola
+ */
+struct graph_bits {
+    // Indice del bit a 1 meno significativo di una parola non nulla
+    static int lowest_bit(unsigned long long w) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(w);
+#else
+        int k = 0;
+        while (!(w & 1)) {
+            w >>= 1;
+            ++k;
+        }
+        return k;
+#endif
+    }
+    
+    // Conta i bit a 1 di una parola (istruzione popcnt dove disponibile)
+    static int popcount(unsigned long long w) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(w);
+#else
+        int c = 0;
+        for (; w != 0; w &= w - 1)
+            ++c;
+        return c;
+#endif
+    }
+};
+
+/**
+    Criteri di ordinamento dei nodi usati da Graph::reorder.
+ 
+    @brief Criteri di riordinamento dei nodi
+ */
+enum graph_order {
+    ORDER_RCM,     ///< Reverse Cuthill-McKee
+    ORDER_BFS,     ///< visita in ampiezza
+    ORDER_DEGREE   ///< grado decrescente
+};
+
+/**
+    Algoritmi di colorazione usati da Graph::coloring.
+ 
+    @brief Algoritmi di colorazione dei nodi
+ */
+enum graph_coloring {
+    COLOR_DSATUR,          ///< DSatur (saturazione massima)
+    COLOR_LARGEST_FIRST,   ///< greedy per grado decrescente
+    COLOR_JONES_PLASSMANN  ///< parallela per turni di insiemi indipendenti
+};
+
+template <typename T, typename E> class GraphView;
+template <typename T, typename E> class GraphQueryExecutor;
+template <typename T, typename E> class MultiGraph;
+template <typename T, typename E> class VersionedGraph;
+
 /**
     Classe che implementa un grafo diretto di dati generici di tipo T.
     L'uguaglianza tra due dati di tipo T è fatta usando un funtore di
@@ -44,375 +395,2679 @@ public:
  
     @param T tipo del dato
     @param E funtore di comparazione (uguaglianza) tra due dati
+    @param S politica delle statistiche (no_stats oppure collect_stats)
  */
-template <typename T, typename E>
-class Graph {
+template <typename T, typename E, typename S = no_stats>
+class Graph : private S {
     
     T *array;          // Puntatore all'array dinamico di T
     bool **adjMatrix;  // Puntatore array bidimensionale dinamico
+    int *in_deg;       // Grado entrante di ogni nodo
+    int *out_deg;      // Grado uscente di ogni nodo
+    bool **revMatrix;  // Matrice trasposta (indice inverso), nullptr se non attivo
+    bool rev_index;    // true se l'indice inverso è mantenuto
     int n_node;        // Numero di nodi
+    int n_spare;       // Posizioni allocate oltre n_node (righe, colonne e array)
     E _eql;            // Istanza del funtore di uguaglianza
     
+    friend class GraphView<T,E>;
+    friend class GraphQueryExecutor<T,E>;
+    friend class MultiGraph<T,E>;
+    friend class VersionedGraph<T,E>;
+    template <typename K, typename KE, typename H> friend class InternedGraph;
+    
+    static const int TILE = 64; // Lato dei blocchi per la trasposizione
+    enum { RUSSIAN_BITS = 8,    // Righe per tabella nel prodotto dei Quattro Russi
+           BLOCK_WORDS = 64 };  // Parole per blocco di colonne nel prodotto booleano
     
-public:
     /**
-        @brief Costruttore di default
+        Metodo per confrontare due dati con il funtore di uguaglianza,
+        contando la chiamata nelle statistiche.
      
-        Costruttore di default per istanziare un grafo vuoto.
+        @brief Metodo per il confronto di uguaglianza tra due dati.
+     */
+    bool eql(const T &a, const T &b) const {
+        this->stats_add(&graph_stats::eql_calls, 1);
+        return _eql(a, b);
+    }
+    
+    /**
+        Metodo per contare nelle statistiche la riallocazione di un grafo di
+        n_alloc nodi in cui vengono copiati i dati di n_copy nodi.
      
-        @post adjMatrix == nullptr
-        @post n_node == 0
+        @brief Metodo per contare allocazioni e copie.
      */
-    Graph() : array(nullptr), adjMatrix(nullptr), n_node(0){}
+    void count_realloc(long long n_alloc, long long n_copy) const {
+        const long long per_node = sizeof(bool*) + sizeof(T) + 2 * sizeof(int);
+        this->stats_add(&graph_stats::allocations, n_alloc + 4);
+        this->stats_add(&graph_stats::bytes_allocated, n_alloc * n_alloc * sizeof(bool) + n_alloc * per_node);
+        this->stats_add(&graph_stats::bytes_copied, n_copy * n_copy * sizeof(bool) + n_copy * per_node);
+    }
     
     /**
-        @brief Copy constructor
+        Metodo per costruire la matrice di adiacenza compattata a bit: la riga i
+        occupa words parole da 64 bit a partire da bits[i * words]. Se
+        symmetric è true il bit (i, j) vale 1 se esiste l'arco i->j oppure j->i
+        e i cappi sono ignorati (vista non orientata).
      
-        Costruttore di copia tra un grafo e un altro grafo.
+        @brief Metodo per compattare a bit la matrice di adiacenza.
+     
+        @param symmetric true per la vista non orientata senza cappi.
+        @param words numero di parole per riga (output).
+     
+        @return righe compattate, una dopo l'altra.
+     */
+    std::vector<unsigned long long> packed_rows(bool symmetric, int &words) const {
+        words = (n_node + 63) / 64;
+        std::vector<unsigned long long> bits((size_t)n_node * words, 0);
+        for (int i = 0; i < n_node; ++i) {
+            const bool *row = adjMatrix[i];
+            unsigned long long *bi = &bits[(size_t)i * words];
+            for (int j = 0; j < n_node; ++j) {
+                if (!row[j])
+                    continue;
+                if (!symmetric) {
+                    bi[j >> 6] |= 1ULL << (j & 63);
+                } else if (j != i) {
+                    bi[j >> 6] |= 1ULL << (j & 63);
+                    bits[(size_t)j * words + (i >> 6)] |= 1ULL << (i & 63);
+                }
+            }
+        }
+        return bits;
+    }
+    
+    /**
+        Metodo per contare, per ogni nodo, i triangoli (non orientati) a cui
+        partecipa. Per ogni vicino j di i si conta |N(i) ∩ N(j)|: con
+        un'intersezione delle liste ordinate se i due nodi hanno pochi vicini,
+        altrimenti con AND e popcount delle righe compattate a bit. Le righe
+        sono divise tra i thread.
+     
+        @brief Metodo per contare i triangoli di ogni nodo.
+     
+        @param threads numero di thread (0 = numero di core disponibili).
+        @param udeg se non nullo, riceve il numero di vicini (non orientati) di ogni nodo.
+     
+        @return numero di triangoli di ogni nodo.
+     */
+    std::vector<long long> local_triangles(unsigned int threads, std::vector<int> *udeg = nullptr) const {
+        const int n = n_node;
+        std::vector<long long> tri(n, 0);
+        if (n == 0)
+            return tri;
+        int words = 0;
+        const std::vector<unsigned long long> bits = packed_rows(true, words);
+        // Liste di adiacenza ordinate per il percorso sparso
+        std::vector<std::vector<int> > nbr(n);
+        for (int i = 0; i < n; ++i) {
+            const unsigned long long *bi = &bits[(size_t)i * words];
+            for (int w = 0; w < words; ++w) {
+                for (unsigned long long x = bi[w]; x != 0; x &= x - 1)
+                    nbr[i].push_back(w * 64 + graph_bits::lowest_bit(x));
+            }
+            if (udeg != nullptr)
+                udeg->push_back(nbr[i].size());
+        }
+        const unsigned long long *b = &bits[0];
+        const std::vector<int> *adj = &nbr[0];
+        long long *out = &tri[0];
+        parallel_for(0, n, threads, [=](int lo, int hi) {
+            for (int i = lo; i < hi; ++i) {
+                const std::vector<int> &ni = adj[i];
+                const unsigned long long *bi = b + (size_t)i * words;
+                long long common = 0;
+                for (unsigned int k = 0; k < ni.size(); ++k) {
+                    const int j = ni[k];
+                    const std::vector<int> &nj = adj[j];
+                    if ((int)(ni.size() + nj.size()) < words) {
+                        unsigned int x = 0, y = 0;
+                        while (x < ni.size() && y < nj.size()) {
+                            if (ni[x] < nj[y])
+                                ++x;
+                            else if (ni[x] > nj[y])
+                                ++y;
+                            else {
+                                ++common;
+                                ++x;
+                                ++y;
+                            }
+                        }
+                    } else {
+                        const unsigned long long *bj = b + (size_t)j * words;
+                        for (int w = 0; w < words; ++w)
+                            common += graph_bits::popcount(bi[w] & bj[w]);
+                    }
+                }
+                out[i] = common / 2;
+            }
+        });
+        return tri;
+    }
+    
+    /**
+        Metodo per associare i nodi del grafo corrente e di other a un insieme
+        di nodi comune, confrontandoli per valore. Con intersect false
+        l'insieme è l'unione (prima i nodi del grafo corrente, poi quelli solo
+        in other), altrimenti è l'intersezione nell'ordine del grafo corrente.
+     
+        @brief Metodo per allineare i nodi di due grafi.
+     
+        @param other secondo grafo.
+        @param intersect true per l'intersezione, false per l'unione.
+        @param nodes nodi dell'insieme comune (output).
+        @param pos posizione di ogni nodo corrente nell'insieme, -1 se assente (output).
+        @param opos posizione di ogni nodo di other nell'insieme, -1 se assente (output).
+     */
+    void align(const Graph &other, bool intersect, std::vector<T> &nodes, std::vector<int> &pos, std::vector<int> &opos) const {
+        // match[j] = indice nel grafo corrente del nodo j di other
+        std::vector<int> match(other.n_node, -1);
+        std::vector<char> shared(n_node, 0);
+        for (int j = 0; j < other.n_node; ++j) {
+            if (j < n_node && eql(other.array[j], array[j]))
+                match[j] = j;
+            else
+                match[j] = index_of(other.array[j]);
+            if (match[j] >= 0)
+                shared[match[j]] = 1;
+        }
+        nodes.clear();
+        pos.assign(n_node, -1);
+        opos.assign(other.n_node, -1);
+        for (int i = 0; i < n_node; ++i) {
+            if (!intersect || shared[i]) {
+                pos[i] = nodes.size();
+                nodes.push_back(array[i]);
+            }
+        }
+        for (int j = 0; j < other.n_node; ++j) {
+            if (match[j] >= 0) {
+                opos[j] = pos[match[j]];
+            } else if (!intersect) {
+                opos[j] = nodes.size();
+                nodes.push_back(other.array[j]);
+            }
+        }
+    }
+    
+    /**
+        Metodo per compattare a bit la matrice di adiacenza riportando i nodi
+        nelle posizioni di un insieme di n nodi (vedi align). Gli archi verso
+        nodi assenti dall'insieme sono ignorati.
+     
+        @brief Metodo per compattare a bit la matrice su un insieme allineato.
+     
+        @param pos posizione di ogni nodo nell'insieme, -1 se assente.
+        @param n numero di nodi dell'insieme.
+        @param words numero di parole per riga.
+     
+        @return righe compattate, una dopo l'altra.
+     */
+    std::vector<unsigned long long> packed_aligned(const std::vector<int> &pos, int n, int words) const {
+        std::vector<unsigned long long> bits((size_t)n * words, 0);
+        for (int i = 0; i < n_node; ++i) {
+            if (pos[i] < 0)
+                continue;
+            const bool *row = adjMatrix[i];
+            unsigned long long *bi = &bits[(size_t)pos[i] * words];
+            for (int j = 0; j < n_node; ++j) {
+                if (row[j] && pos[j] >= 0)
+                    bi[pos[j] >> 6] |= 1ULL << (pos[j] & 63);
+            }
+        }
+        return bits;
+    }
+    
+    /**
+        Metodo per costruire un grafo dai suoi nodi e dalle righe compattate
+        a bit della matrice di adiacenza.
+     
+        @brief Metodo per costruire un grafo da una matrice compattata.
+     
+        @param nodes nodi del grafo.
+        @param bits righe compattate (words parole per riga).
+        @param words numero di parole per riga.
      
-        @param other grafo da copiare
         @throw eccezione allocazione di memoria
+        @throw eccezione copia dei valori
+     
+        @return grafo costruito.
      */
-    Graph(const Graph &other) : array(nullptr), adjMatrix(nullptr), n_node(0) {
-        try {
-        adjMatrix = new bool*[other.n_node]();
-        array = new T [other.n_node]();
-        n_node = other.n_node;
-        
-            for (unsigned int i = 0; i < other.n_node; i++) {
-                adjMatrix[i] = new bool[n_node]();
-                array[i] = other.array[i];
-                for (unsigned int j = 0; j < other.n_node; j++)
-                    adjMatrix[i][j] = other.adjMatrix[i][j];
+    static Graph from_packed(const std::vector<T> &nodes, const std::vector<unsigned long long> &bits, int words) {
+        const int n = nodes.size();
+        Graph g;
+        g.adjMatrix = new bool*[n]();
+        g.array = new T [n]();
+        g.in_deg = new int[n]();
+        g.out_deg = new int[n]();
+        g.n_node = n;
+        for (int i = 0; i < n; ++i) {
+            g.adjMatrix[i] = new bool[n]();
+            g.array[i] = nodes[i];
+        }
+        for (int i = 0; i < n; ++i) {
+            const unsigned long long *bi = &bits[(size_t)i * words];
+            bool *row = g.adjMatrix[i];
+            for (int w = 0; w < words; ++w) {
+                for (unsigned long long x = bi[w]; x != 0; x &= x - 1) {
+                    const int j = w * 64 + graph_bits::lowest_bit(x);
+                    row[j] = true;
+                    ++g.out_deg[i];
+                    ++g.in_deg[j];
+                }
             }
         }
-        catch(...) {
-            clear();
-            throw;
+        return g;
+    }
+    
+    /**
+        Metodo per il prodotto booleano C |= A * B di due matrici n x n
+        compattate a bit, con il metodo dei Quattro Russi: le righe di B sono
+        prese a gruppi di RUSSIAN_BITS e per ogni gruppo si precalcola la
+        tabella degli OR di tutti i loro sottoinsiemi, così ogni riga di C
+        riceve un solo OR di tabella per gruppo. Le colonne sono divise in
+        blocchi di BLOCK_WORDS parole, perché la tabella resti in cache. Il
+        lavoro è diviso tra i thread per blocco di colonne e, se i blocchi
+        sono meno dei thread, anche per fette di righe.
+     
+        @brief Metodo per il prodotto booleano di matrici compattate.
+     
+        @param a righe di A.
+        @param b righe di B.
+        @param c righe di C, già allocate.
+        @param n lato delle matrici.
+        @param words numero di parole per riga.
+        @param threads numero di thread (0 = numero di core disponibili).
+     */
+    static void multiply_packed(const unsigned long long *a, const unsigned long long *b, unsigned long long *c, int n, int words, unsigned int threads) {
+        const int blocks = (words + BLOCK_WORDS - 1) / BLOCK_WORDS;
+        if (threads == 0)
+            threads = std::thread::hardware_concurrency();
+        if (threads == 0)
+            threads = 1;
+        // ogni fetta di righe ricostruisce la propria tabella: almeno
+        // 1 << RUSSIAN_BITS righe per fetta, quante le voci della tabella
+        int slices = ((int)threads + blocks - 1) / blocks;
+        slices = std::max(1, std::min(slices, n >> RUSSIAN_BITS));
+        parallel_for(0, blocks * slices, threads, [=](int lo, int hi) {
+            std::vector<unsigned long long> table((1 << RUSSIAN_BITS) * BLOCK_WORDS, 0);
+            for (int task = lo; task < hi; ++task) {
+                const int w0 = (task / slices) * BLOCK_WORDS;
+                const int bw = std::min((int)BLOCK_WORDS, words - w0);
+                const int i0 = (int)((long long)n * (task % slices) / slices);
+                const int i1 = (int)((long long)n * (task % slices + 1) / slices);
+                for (int g = 0; g < n; g += RUSSIAN_BITS) {
+                    const int gs = std::min((int)RUSSIAN_BITS, n - g);
+                    const unsigned int gmask = (1u << gs) - 1;
+                    // tabella[m] = OR delle righe g + k di B con il bit k di m a 1
+                    for (unsigned int m = 1; m <= gmask; ++m) {
+                        const unsigned long long *prev = &table[(size_t)(m & (m - 1)) * BLOCK_WORDS];
+                        const unsigned long long *row = b + (size_t)(g + graph_bits::lowest_bit(m)) * words + w0;
+                        unsigned long long *t = &table[(size_t)m * BLOCK_WORDS];
+                        for (int w = 0; w < bw; ++w)
+                            t[w] = prev[w] | row[w];
+                    }
+                    for (int i = i0; i < i1; ++i) {
+                        const unsigned int m = (a[(size_t)i * words + (g >> 6)] >> (g & 63)) & gmask;
+                        if (m == 0)
+                            continue;
+                        const unsigned long long *t = &table[(size_t)m * BLOCK_WORDS];
+                        unsigned long long *ci = c + (size_t)i * words + w0;
+                        for (int w = 0; w < bw; ++w)
+                            ci[w] |= t[w];
+                    }
+                }
+            }
+        });
+    }
+    
+    // Prodotto booleano di due matrici compattate n x n
+    static std::vector<unsigned long long> multiply(const std::vector<unsigned long long> &a, const std::vector<unsigned long long> &b, int n, int words, unsigned int threads) {
+        std::vector<unsigned long long> c(a.size(), 0);
+        if (n > 0)
+            multiply_packed(&a[0], &b[0], &c[0], n, words, threads);
+        return c;
+    }
+    
+    // Potenza k-esima di una matrice compattata n_node x n_node per quadrati successivi
+    std::vector<unsigned long long> matrix_power(std::vector<unsigned long long> base, int k, int words, unsigned int threads) const {
+        std::vector<unsigned long long> result;
+        bool identity = true;  // result vale ancora la matrice identità
+        while (k > 0) {
+            if (k & 1) {
+                result = identity ? base : multiply(result, base, n_node, words, threads);
+                identity = false;
+            }
+            k >>= 1;
+            if (k > 0)
+                base = multiply(base, base, n_node, words, threads);
+        }
+        if (identity) {
+            result.assign((size_t)n_node * words, 0);
+            for (int i = 0; i < n_node; ++i)
+                result[(size_t)i * words + (i >> 6)] |= 1ULL << (i & 63);
+        }
+        return result;
+    }
+    
+    
+    // Legge un intero in formato varint; lancia 980 se i dati sono troncati o troppo lunghi
+    static unsigned long long read_varint(std::istream &in) {
+        unsigned long long v = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            const int c = in.get();
+            if (c == std::char_traits<char>::eof()) {
+                throw customException("Valore non valido!", 980);
+            }
+            v |= (unsigned long long)(c & 0x7f) << shift;
+            if (!(c & 0x80))
+                return v;
+        }
+        throw customException("Valore non valido!", 980);
+    }
+    
+    // Scrive una lista di archi ordinata, con le differenze tra coppie consecutive
+    static void write_edges(graph_writer &w, std::vector<std::pair<int,int> > edges) {
+        std::sort(edges.begin(), edges.end());
+        w.write_varint(edges.size());
+        int prev_a = 0, prev_b = -1;
+        for (unsigned int e = 0; e < edges.size(); ++e) {
+            if (edges[e].first != prev_a)
+                prev_b = -1;
+            w.write_varint(edges[e].first - prev_a);
+            w.write_varint(edges[e].second - prev_b - 1);
+            prev_a = edges[e].first;
+            prev_b = edges[e].second;
+        }
+    }
+    
+    // Legge una lista di archi scritta con write_edges
+    static void read_edges(std::istream &in, std::vector<std::pair<int,int> > &edges) {
+        const unsigned long long n = read_varint(in);
+        long long a = 0, b = -1;
+        for (unsigned long long e = 0; e < n; ++e) {
+            const unsigned long long da = read_varint(in);
+            const unsigned long long db = read_varint(in);
+            if (da > 0)
+                b = -1;
+            if (da > (unsigned long long)INT_MAX - a || db > (unsigned long long)INT_MAX - (b + 1)) {
+                throw customException("Valore non valido!", 980);
+            }
+            a += da;
+            b += db + 1;
+            edges.push_back(std::make_pair((int)a, (int)b));
+        }
+    }
+    
+    // Serializza un nodo come testo (operatore <<) preceduto dalla lunghezza
+    static void write_text_node(graph_writer &w, const T &node) {
+        std::ostringstream oss;
+        oss << node;
+        const std::string s = oss.str();
+        w.write_varint(s.size());
+        w.write(s);
+    }
+    
+    // Legge i byte di un nodo scritto con write_text_node
+    static std::string read_text(std::istream &in) {
+        const unsigned long long len = read_varint(in);
+        std::string s;
+        char buf[256];
+        for (unsigned long long done = 0; done < len; ) {
+            const std::streamsize chunk = std::min<unsigned long long>(len - done, sizeof(buf));
+            in.read(buf, chunk);
+            if (in.gcount() != chunk) {
+                throw customException("Valore non valido!", 980);
+            }
+            s.append(buf, chunk);
+            done += chunk;
+        }
+        return s;
+    }
+    
+    // Converte il testo di un nodo in T con l'operatore >>
+    template <typename U>
+    static void parse_text(const std::string &s, U &node) {
+        std::istringstream iss(s);
+        iss >> node;
+        if (iss.fail()) {
+            throw customException("Valore non valido!", 980);
+        }
+    }
+    
+    // Le stringhe sono copiate per intero, spazi compresi
+    static void parse_text(const std::string &s, std::string &node) {
+        node = s;
+    }
+    
+    // Legge un nodo scritto con write_text_node
+    static T read_text_node(std::istream &in) {
+        T node = T();
+        parse_text(read_text(in), node);
+        return node;
+    }
+    
+    // Liste dei vicini non orientati di ogni nodo, senza cappi, in ordine di indice
+    std::vector<std::vector<int> > undirected_lists() const {
+        int words = 0;
+        const std::vector<unsigned long long> bits = packed_rows(true, words);
+        std::vector<std::vector<int> > nbr(n_node);
+        for (int i = 0; i < n_node; ++i) {
+            const unsigned long long *bi = &bits[(size_t)i * words];
+            for (int w = 0; w < words; ++w) {
+                for (unsigned long long x = bi[w]; x != 0; x &= x - 1)
+                    nbr[i].push_back(w * 64 + graph_bits::lowest_bit(x));
+            }
+        }
+        return nbr;
+    }
+    
+    // Priorità pseudocasuale ma riproducibile di un nodo (finalizzatore splitmix64)
+    static unsigned long long node_hash(unsigned long long i) {
+        i += 0x9E3779B97F4A7C15ULL;
+        i = (i ^ (i >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        i = (i ^ (i >> 27)) * 0x94D049BB133111EBULL;
+        return i ^ (i >> 31);
+    }
+    
+    // Colore più basso con il bit a 0 nella riga dei colori vietati
+    static int first_free(const unsigned long long *forbidden, int words) {
+        for (int w = 0; w < words; ++w) {
+            if (~forbidden[w] != 0)
+                return w * 64 + graph_bits::lowest_bit(~forbidden[w]);
+        }
+        return words * 64;
+    }
+    
+    /**
+        Metodo per la colorazione greedy nell'ordine indicato: ogni nodo
+        riceve il colore più basso non usato dai vicini già colorati, letto
+        da una riga di bit dei colori vietati.
+     
+        @brief Metodo per la colorazione greedy in un ordine dato.
+     
+        @param nbr liste dei vicini non orientati.
+        @param order ordine in cui colorare i nodi.
+        @param words parole della riga dei colori vietati.
+     
+        @return colore di ogni nodo.
+     */
+    static std::vector<int> greedy_coloring(const std::vector<std::vector<int> > &nbr, const std::vector<int> &order, int words) {
+        std::vector<int> color(nbr.size(), -1);
+        std::vector<unsigned long long> forbidden(words, 0);
+        for (unsigned int k = 0; k < order.size(); ++k) {
+            const std::vector<int> &nv = nbr[order[k]];
+            for (unsigned int x = 0; x < nv.size(); ++x) {
+                const int c = color[nv[x]];
+                if (c >= 0)
+                    forbidden[c >> 6] |= 1ULL << (c & 63);
+            }
+            color[order[k]] = first_free(&forbidden[0], words);
+            for (unsigned int x = 0; x < nv.size(); ++x) {
+                const int c = color[nv[x]];
+                if (c >= 0)
+                    forbidden[c >> 6] = 0;
+            }
+        }
+        return color;
+    }
+    
+    /**
+        Metodo per la colorazione DSatur: si colora ogni volta il nodo con più
+        colori distinti tra i vicini (saturazione), a parità quello di grado
+        maggiore. Ogni nodo ha la sua riga di bit dei colori vietati, da cui
+        si leggono sia la saturazione sia il colore da assegnare.
+     
+        @brief Metodo per la colorazione DSatur.
+     
+        @param nbr liste dei vicini non orientati.
+        @param words parole della riga dei colori vietati.
+     
+        @return colore di ogni nodo.
+     */
+    static std::vector<int> dsatur_coloring(const std::vector<std::vector<int> > &nbr, int words) {
+        const int n = nbr.size();
+        std::vector<int> color(n, -1), sat(n, 0);
+        std::vector<unsigned long long> forbidden((size_t)n * words, 0);
+        // (-saturazione, -grado, nodo): il primo elemento è il prossimo da colorare
+        typedef std::pair<std::pair<int,int>,int> key;
+        std::set<key> queue;
+        for (int i = 0; i < n; ++i)
+            queue.insert(key(std::make_pair(0, -(int)nbr[i].size()), i));
+        while (!queue.empty()) {
+            const int v = queue.begin()->second;
+            queue.erase(queue.begin());
+            const int c = first_free(&forbidden[(size_t)v * words], words);
+            color[v] = c;
+            for (unsigned int x = 0; x < nbr[v].size(); ++x) {
+                const int u = nbr[v][x];
+                unsigned long long &w = forbidden[(size_t)u * words + (c >> 6)];
+                if (color[u] >= 0 || (w & (1ULL << (c & 63))))
+                    continue;
+                queue.erase(key(std::make_pair(-sat[u], -(int)nbr[u].size()), u));
+                w |= 1ULL << (c & 63);
+                ++sat[u];
+                queue.insert(key(std::make_pair(-sat[u], -(int)nbr[u].size()), u));
+            }
+        }
+        return color;
+    }
+    
+    /**
+        Metodo per la colorazione parallela alla Jones-Plassmann: ad ogni turno
+        i nodi non colorati con priorità (grado, poi hash del nodo) maggiore
+        di tutti i vicini non colorati formano un insieme indipendente e si
+        colorano in parallelo come nella colorazione greedy. Il risultato non
+        dipende dal numero di thread.
+     
+        @brief Metodo per la colorazione parallela Jones-Plassmann.
+     
+        @param nbr liste dei vicini non orientati.
+        @param words parole della riga dei colori vietati.
+        @param threads numero di thread (0 = numero di core disponibili).
+     
+        @return colore di ogni nodo.
+     */
+    static std::vector<int> jones_plassmann_coloring(const std::vector<std::vector<int> > &nbr, int words, unsigned int threads) {
+        const int n = nbr.size();
+        std::vector<int> color(n, -1), active(n);
+        std::vector<unsigned long long> prio(n);
+        for (int i = 0; i < n; ++i) {
+            active[i] = i;
+            prio[i] = node_hash(i);
+        }
+        std::vector<char> selected(n, 0);
+        while (!active.empty()) {
+            const std::vector<std::vector<int> > &adj = nbr;
+            // 1. Scelta dei massimi locali tra i nodi non colorati
+            parallel_for(0, active.size(), threads, [&](int lo, int hi) {
+                for (int k = lo; k < hi; ++k) {
+                    const int v = active[k];
+                    const int dv = adj[v].size();
+                    char sel = 1;
+                    for (unsigned int x = 0; x < adj[v].size() && sel; ++x) {
+                        const int u = adj[v][x];
+                        const int du = adj[u].size();
+                        if (color[u] < 0 && (du > dv || (du == dv && (prio[u] > prio[v] || (prio[u] == prio[v] && u > v)))))
+                            sel = 0;
+                    }
+                    selected[k] = sel;
+                }
+            });
+            // 2. Colorazione dei nodi scelti: i loro vicini non cambiano colore in questo turno
+            parallel_for(0, active.size(), threads, [&](int lo, int hi) {
+                std::vector<unsigned long long> forbidden(words, 0);
+                for (int k = lo; k < hi; ++k) {
+                    if (!selected[k])
+                        continue;
+                    const std::vector<int> &nv = adj[active[k]];
+                    for (unsigned int x = 0; x < nv.size(); ++x) {
+                        const int c = color[nv[x]];
+                        if (c >= 0)
+                            forbidden[c >> 6] |= 1ULL << (c & 63);
+                    }
+                    color[active[k]] = first_free(&forbidden[0], words);
+                    for (unsigned int x = 0; x < nv.size(); ++x) {
+                        const int c = color[nv[x]];
+                        if (c >= 0)
+                            forbidden[c >> 6] = 0;
+                    }
+                }
+            });
+            int kept = 0;
+            for (unsigned int k = 0; k < active.size(); ++k) {
+                if (!selected[k])
+                    active[kept++] = active[k];
+            }
+            active.resize(kept);
+        }
+        return color;
+    }
+    
+    // Confronta due indici di nodo per grado crescente
+    struct degree_less {
+        const std::vector<int> &deg;
+        explicit degree_less(const std::vector<int> &d) : deg(d) {}
+        bool operator()(int a, int b) const {
+            return deg[a] < deg[b];
+        }
+    };
+    
+    // Confronta due indici di nodo per grado decrescente
+    struct degree_greater {
+        const std::vector<int> &deg;
+        explicit degree_greater(const std::vector<int> &d) : deg(d) {}
+        bool operator()(int a, int b) const {
+            return deg[a] > deg[b];
+        }
+    };
+    
+    // Formatta ogni nodo con l'operatore << di T
+    std::vector<std::string> node_labels() const {
+        std::vector<std::string> labels(n_node);
+        for (int i = 0; i < n_node; ++i) {
+            std::ostringstream oss;
+            oss << array[i];
+            labels[i] = oss.str();
+        }
+        return labels;
+    }
+    
+    /**
+        Metodo per costruire l'eccezione custom con il codice indicato,
+        contandola nelle statistiche.
+     
+        @brief Metodo per costruire un'eccezione custom.
+     
+        @param code codice di errore.
+     
+        @return eccezione da lanciare.
+     */
+    customException error(int code) const {
+        this->stats_add(&graph_stats::exceptions, 1);
+        return customException("Valore non valido!", code);
+    }
+    
+    /**
+        Metodo per conoscere la posizione di un nodo nell'array dei nodi.
+     
+        @brief Metodo per conoscere l'indice di un nodo.
+     
+        @param node nodo da cercare.
+     
+        @return indice del nodo, -1 se il nodo non esiste.
+     */
+    int index_of(const T &node) const {
+        for (int i = 0; i < n_node; ++i) {
+            if (eql(array[i], node))
+                return i;
+        }
+        return -1;
+    }
+    
+    /**
+        Metodo per eseguire f(lo, hi) su blocchi contigui dell'intervallo
+        [begin, end), un blocco per thread. Il primo blocco è eseguito dal
+        thread chiamante, come i blocchi per cui non è stato possibile
+        creare un thread.
+     
+        @brief Metodo per dividere un ciclo tra più thread.
+     
+        @param begin inizio dell'intervallo.
+        @param end fine dell'intervallo (esclusa).
+        @param threads numero di thread (0 = numero di core disponibili).
+        @param f funzione da eseguire su ogni blocco, non deve lanciare eccezioni.
+     */
+    template <typename F>
+    static void parallel_for(int begin, int end, unsigned int threads, F f) {
+        const int n = end - begin;
+        if (threads == 0)
+            threads = std::thread::hardware_concurrency();
+        if (threads == 0)
+            threads = 1;
+        if (n <= 0)
+            return;
+        if ((int)threads > n)
+            threads = n;
+        if (threads == 1) {
+            f(begin, end);
+            return;
+        }
+        const int chunk = (n + threads - 1) / threads;
+        std::vector<std::thread> pool;
+        pool.reserve(threads - 1);  // push_back non rialloca con thread già avviati
+        int lo = begin + chunk;
+        try {
+            for (; lo < end; lo += chunk) {
+                pool.push_back(std::thread(f, lo, std::min(lo + chunk, end)));
+            }
+        } catch (const std::system_error &) {
+            // thread esauriti: i blocchi da lo in poi sono eseguiti qui sotto
+        }
+        f(begin, begin + chunk);
+        if (lo < end)
+            f(lo, end);
+        for (unsigned int t = 0; t < pool.size(); ++t) {
+            pool[t].join();
+        }
+    }
+    
+    /**
+        Metodo per copiare le righe di una matrice quadrata n x n già allocata,
+        dividendo le righe tra più thread.
+     
+        @brief Metodo per la copia parallela di una matrice.
+     
+        @param src matrice sorgente.
+        @param dst matrice destinazione, già allocata.
+        @param n lato delle matrici.
+        @param threads numero di thread (0 = numero di core disponibili).
+     */
+    static void copy_rows(bool * const *src, bool **dst, int n, unsigned int threads) {
+        parallel_for(0, n, threads, [=](int lo, int hi) {
+            for (int i = lo; i < hi; ++i)
+                std::memcpy(dst[i], src[i], n * sizeof(bool));
+        });
+    }
+    
+    /**
+        Metodo per trasporre una matrice quadrata n x n a blocchi di TILE x TILE,
+        in modo che sia la lettura che la scrittura restino in cache.
+     
+        @brief Metodo per la trasposizione a blocchi di una matrice.
+     
+        @param src matrice sorgente.
+        @param dst matrice destinazione, già allocata.
+        @param n lato delle matrici.
+     */
+    static void transpose_blocked(bool * const *src, bool **dst, int n) {
+        for (int ii = 0; ii < n; ii += TILE) {
+            const int ie = std::min(ii + TILE, n);
+            for (int jj = 0; jj < n; jj += TILE) {
+                const int je = std::min(jj + TILE, n);
+                for (int i = ii; i < ie; ++i) {
+                    const bool *row = src[i];
+                    for (int j = jj; j < je; ++j)
+                        dst[j][i] = row[j];
+                }
+            }
+        }
+    }
+    
+    /**
+        Metodo per costruire l'indice inverso a partire dalla matrice di
+        adiacenza. In caso di errore l'indice viene disattivato.
+     
+        @brief Metodo per costruire l'indice inverso.
+     
+        @pre revMatrix == nullptr
+        @throw eccezione allocazione di memoria
+     */
+    void build_reverse() {
+        this->stats_add(&graph_stats::allocations, n_node + 1);
+        this->stats_add(&graph_stats::bytes_allocated, (long long)n_node * (n_node * sizeof(bool) + sizeof(bool*)));
+        this->stats_add(&graph_stats::bytes_copied, (long long)n_node * n_node * sizeof(bool));
+        try {
+            revMatrix = new bool*[n_node]();
+            for (int i = 0; i < n_node; ++i)
+                revMatrix[i] = new bool[n_node];
+            transpose_blocked(adjMatrix, revMatrix, n_node);
+        } catch (...) {
+            free_reverse();
+            rev_index = false;
+            throw;
+        }
+    }
+    
+    /**
+        Metodo per riallocare matrice e array con cap posizioni, di cui le
+        prime n_node restano occupate dai nodi. Le posizioni di riserva
+        hanno righe e colonne senza archi. Non confronta nodi.
+     
+        @brief Metodo per cambiare la capacità del grafo.
+     
+        @param cap nuova capacità, almeno n_node.
+     
+        @throw eccezione allocazione di memoria (il grafo resta invariato)
+     */
+    void reserve_positions(int cap) {
+        count_realloc(cap, n_node);
+        bool **_adjMatrix = new bool*[cap]();
+        T *_array = nullptr;
+        int *_in_deg = nullptr;
+        int *_out_deg = nullptr;
+        try {
+            _array = new T [cap]();
+            _in_deg = new int[cap]();
+            _out_deg = new int[cap]();
+            for (int a = 0; a < cap; a++)
+                _adjMatrix[a] = new bool[cap]();
+            for (int i = 0; i < n_node; i++) {
+                _array[i] = array[i];
+                _in_deg[i] = in_deg[i];
+                _out_deg[i] = out_deg[i];
+                std::memcpy(_adjMatrix[i], adjMatrix[i], n_node * sizeof(bool));
+            }
+        } catch (...) {
+            for (int a = 0; a < cap; a++)
+                delete[] _adjMatrix[a];
+            delete[] _adjMatrix;
+            delete[] _array;
+            delete[] _in_deg;
+            delete[] _out_deg;
+            throw;
+        }
+        for (int c = 0; c < n_node + n_spare; c++)
+            delete[] adjMatrix[c];
+        delete[] adjMatrix;
+        delete[] array;
+        delete[] in_deg;
+        delete[] out_deg;
+        adjMatrix = _adjMatrix;
+        array = _array;
+        in_deg = _in_deg;
+        out_deg = _out_deg;
+        n_spare = cap - n_node;
+    }
+    
+    /**
+        Metodo per aggiungere un nodo in ultima posizione senza controllare
+        che esista già. La capacità cresce geometricamente, quindi il costo
+        ammortizzato non dipende dalla matrice.
+     
+        @brief Metodo per aggiungere un nodo in ultima posizione.
+     
+        @param node nodo da aggiungere, che non deve esistere.
+     
+        @throw eccezione allocazione di memoria
+     */
+    void append_position(const T &node) {
+        if (n_spare == 0)
+            reserve_positions(n_node < 8 ? 16 : 2 * n_node);
+        if (rev_index)
+            free_reverse();
+        array[n_node] = node;
+        in_deg[n_node] = 0;
+        out_deg[n_node] = 0;
+        ++n_node;
+        --n_spare;
+        if (rev_index)
+            build_reverse();
+    }
+    
+    /**
+        Metodo per rimuovere il nodo in posizione pos spostando al suo posto
+        l'ultimo nodo, con i suoi archi: le posizioni degli altri nodi non
+        cambiano. L'ultima posizione diventa di riserva; la matrice è
+        riallocata solo quando la capacità supera quattro volte i nodi.
+     
+        @brief Metodo per rimuovere un nodo per posizione.
+     
+        @param pos posizione del nodo da rimuovere.
+     
+        @throw eccezione allocazione di memoria
+     */
+    void remove_position(int pos) {
+        const int last = n_node - 1;
+        if (rev_index)
+            free_reverse();
+        for (int j = 0; j <= last; ++j) {
+            if (adjMatrix[pos][j]) {
+                adjMatrix[pos][j] = false;
+                --out_deg[pos];
+                --in_deg[j];
+            }
+            if (adjMatrix[j][pos]) {
+                adjMatrix[j][pos] = false;
+                --out_deg[j];
+                --in_deg[pos];
+            }
+        }
+        if (pos != last) {
+            for (int j = 0; j <= last; ++j) {
+                adjMatrix[pos][j] = adjMatrix[last][j];
+                adjMatrix[last][j] = false;
+            }
+            for (int i = 0; i <= last; ++i) {
+                adjMatrix[i][pos] = adjMatrix[i][last];
+                adjMatrix[i][last] = false;
+            }
+            array[pos] = array[last];
+            in_deg[pos] = in_deg[last];
+            out_deg[pos] = out_deg[last];
+        }
+        --n_node;
+        ++n_spare;
+        if (n_node + n_spare > 16 && n_spare > 3 * n_node) {
+            try {
+                reserve_positions(std::max(16, 2 * n_node));
+            } catch (const std::bad_alloc &) {
+                // la riduzione è facoltativa: il grafo resta valido con la capacità attuale
+            }
+        }
+        if (rev_index)
+            build_reverse();
+    }
+    
+    // Dealloca l'indice inverso (senza cambiarne lo stato di attivazione)
+    void free_reverse() {
+        if (revMatrix != nullptr) {
+            for (int c = 0; c < n_node; c++) {
+                delete[] revMatrix[c];
+            }
+            delete[] revMatrix;
+            revMatrix = nullptr;
+        }
+    }
+    
+public:
+    /**
+        @brief Costruttore di default
+     
+        Costruttore di default per istanziare un grafo vuoto.
+     
+        @post adjMatrix == nullptr
+        @post n_node == 0
+     */
+    Graph() : array(nullptr), adjMatrix(nullptr), in_deg(nullptr), out_deg(nullptr), revMatrix(nullptr), rev_index(false), n_node(0), n_spare(0){}
+    
+    /**
+        @brief Copy constructor
+     
+        Costruttore di copia tra un grafo e un altro grafo.
+     
+        @param other grafo da copiare
+        @throw eccezione allocazione di memoria
+     */
+    Graph(const Graph &other) : Graph(other, 1) {}
+    
+    /**
+        @brief Copy constructor parallelo
+     
+        Costruttore di copia tra un grafo e un altro grafo. Le righe della
+        matrice di adiacenza (e dell'indice inverso) sono allocate dal thread
+        chiamante e copiate a blocchi di righe da più thread.
+     
+        @param other grafo da copiare
+        @param threads numero di thread (0 = numero di core disponibili)
+        @throw eccezione allocazione di memoria
+        @throw eccezione copia dei valori
+     */
+    Graph(const Graph &other, unsigned int threads) : array(nullptr), adjMatrix(nullptr), in_deg(nullptr), out_deg(nullptr), revMatrix(nullptr), rev_index(false), n_node(0), n_spare(0) {
+        typename S::timer _op_timer(*this, OP_COPY);
+        count_realloc(other.n_node, other.n_node);
+        try {
+        adjMatrix = new bool*[other.n_node]();
+        array = new T [other.n_node]();
+        in_deg = new int[other.n_node]();
+        out_deg = new int[other.n_node]();
+        n_node = other.n_node;
+        
+            for (int i = 0; i < n_node; i++) {
+                adjMatrix[i] = new bool[n_node];
+                array[i] = other.array[i];
+                in_deg[i] = other.in_deg[i];
+                out_deg[i] = other.out_deg[i];
+            }
+            copy_rows(other.adjMatrix, adjMatrix, n_node, threads);
+            if (other.rev_index) {
+                rev_index = true;
+                revMatrix = new bool*[n_node]();
+                for (int i = 0; i < n_node; i++)
+                    revMatrix[i] = new bool[n_node];
+                copy_rows(other.revMatrix, revMatrix, n_node, threads);
+            }
+        }
+        catch(...) {
+            clear();
+            throw;
+        }
+        
+    }
+    
+    /**
+        @brief Distruttore della classe
+     
+        Distruttore della classe. Rimuove dallo heap gli array dinamici
+        allocati in precedenza.
+     
+     */
+    ~Graph() {
+        clear();
+        n_node = 0;
+    }
+    
+    /**
+        Metodo per la rimozione di tutti i nodi negli array e lasciare la memoria in uno stato consistente.
+     
+        @brief Metodo per lasciare la memoria in uno stato consistente.
+     
+     */
+    void clear() {
+        free_reverse();
+        for (unsigned int c = 0; c < n_node + n_spare; c++) {
+            delete[] adjMatrix[c];
+        }
+        delete[] adjMatrix;
+        delete[] array;
+        delete[] in_deg;
+        delete[] out_deg;
+        array = nullptr;
+        adjMatrix = nullptr;
+        in_deg = nullptr;
+        out_deg = nullptr;
+        n_node = 0;
+        n_spare = 0;
+    }
+    
+    /**
+        @brief Operatore di assegnamento
+     
+        Operatore di assegnamento che serve per copiare il contenuto di
+        other in *this. Il costo della copia, fatta su un grafo temporaneo,
+        è aggiunto alle statistiche di *this.
+     
+        @param other Graph da copiare
+        @return reference a Graph
+     */
+    Graph& operator=(const Graph &other) {
+        if (&other != this) {
+            Graph tmp(other);
+            tmp.swap(*this);
+            this->stats_merge(tmp);
+        }
+        return *this;
+    }
+    
+    /**
+     
+        Funzione che scambia gli stati interni tra due grafi. Le statistiche
+        restano a ciascun grafo.
+     
+        @brief Funzione di swap dei dati interni tra due grafi
+     
+        @param other grafo sorgente
+     */
+    void swap(Graph &other) {
+        std::swap(this->array, other.array);
+        std::swap(this->n_node, other.n_node);
+        std::swap(this->n_spare, other.n_spare);
+        std::swap(this->adjMatrix, other.adjMatrix); 
+        std::swap(this->in_deg, other.in_deg);
+        std::swap(this->out_deg, other.out_deg);
+        std::swap(this->revMatrix, other.revMatrix);
+        std::swap(this->rev_index, other.rev_index);
+    }
+
+    /**
+        Metodo per l'inserimento di nuovi nodi nel grafo utilizzando array di appoggio.
+     
+        @brief Metodo per l'inserimento di nuovi nodi nel grafo.
+     
+        @param node nodo che si vuole aggiungere al grafo.
+     
+        @throw eccezione custom che gestisce il caso in cui il nodo già esista
+        @throw eccezione copia dei valori
+     
+    */
+    void addNode(const T &node){
+        typename S::timer _op_timer(*this, OP_ADD_NODE);
+        if (exists(node) == true) {
+            throw error(999);
+        }
+        int _n_node = n_node + 1;
+        count_realloc(_n_node, n_node);
+        // 1. Creo (alloco) una nuova matrice e un nuovo array con n_node aumentati di +1
+        bool **_adjMatrix = new bool*[_n_node](); // matrice  di appoggio temporaneo
+        T *_array = new T [_n_node]();            //array di appoggio temporaneo
+        int *_in_deg = new int[_n_node]();        //gradi di appoggio temporanei
+        int *_out_deg = new int[_n_node]();
+        for (unsigned int a = 0; a < _n_node; a++) {
+            _adjMatrix[a] = new bool[_n_node]();
+        }
+        try {
+            // 2. Copio i vecchi array in quelli nuovi e aggiungo il nodo nuovo
+            for (unsigned int i = 0; i < n_node; i++) {
+                _array[i] = array[i];
+                _in_deg[i] = in_deg[i];
+                _out_deg[i] = out_deg[i];
+                for (unsigned int j = 0; j < n_node; j++) {
+                    _adjMatrix[i][j] = adjMatrix[i][j];
+                }
+            }
+            _array[n_node] = node;
+            _adjMatrix[n_node][n_node] = false;
+            
+        } catch (...) {
+            clear();
+            throw;
+        }
+        // 3. Dealloco quelli vecchi
+        clear();
+        n_node = _n_node;
+        array = _array;
+        adjMatrix = _adjMatrix;
+        in_deg = _in_deg;
+        out_deg = _out_deg;
+        if (rev_index)
+            build_reverse();
+    }
+    
+    /**
+     Metodo per la rimozione di nodi nel grafo utilizzando array di appoggio.
+     
+     @brief Metodo per lla rimozione di nodi nel grafo.
+     
+     @param node nodo che si vuole rimuovere dal grafo.
+     
+     @throw eccezione custom che gestisce il caso in cui il nodo già non esista
+     @throw eccezione copia dei valori
+     
+     */
+    void removeNode(const T &node) {
+        typename S::timer _op_timer(*this, OP_REMOVE_NODE);
+        if (exists(node) != true) {
+            throw error(998);
+        }
+        // Gestire il caso in cui si tenti di rimuovere un nodo dal quale entra/esce un arco!
+        for (unsigned int h = 0; h < n_node; h++) {
+            if(hasEdge(node, array[h]) == true) {
+                removeEdge(node, array[h]);
+            }
+            if(hasEdge(array[h], node) == true) {
+                removeEdge(array[h], node);
+            }
+        }
+        int _n_node = n_node - 1;
+        count_realloc(_n_node, _n_node);
+        this->stats_add(&graph_stats::allocations, 1);
+        this->stats_add(&graph_stats::bytes_allocated, (long long)_n_node * _n_node * sizeof(bool));
+        this->stats_add(&graph_stats::bytes_copied, (long long)_n_node * _n_node * sizeof(bool));
+        // 1. Creo (alloco) una nuova matrice e un nuovo array con n_node diminuiti di -1
+        bool **_adjMatrix = new bool*[_n_node](); // matrice  di appoggio temporaneo
+        T *_array = new T [_n_node]();            // array di appoggio temporaneo
+        int *_in_deg = new int[_n_node]();        // gradi di appoggio temporanei
+        int *_out_deg = new int[_n_node]();
+        for (unsigned int a = 0; a < _n_node; a++) {
+            _adjMatrix[a] = new bool[_n_node]();
+        }
+        bool* temp_linear = new bool[_n_node * _n_node](); //array temporaneo di appoggio per la copia dei valori nella adjMatrix
+        // 2. Tolgo il nodo da togliere e copio i vecchi array in quelli nuovi
+        int cont = 0;
+        for (unsigned int c = 0; c < n_node; c++) {
+            if (eql(array[c], node) == true) {
+                cont = c;
+            }
+        }
+        try {
+            int k = 0;
+            for ( int q = 0; q < n_node; q++ ) {
+                for ( int u = 0; u < n_node; u++ ) {
+                    if (q != cont && u != cont) {
+                        temp_linear[k] = adjMatrix[q][u];
+                        k++;
+                    }
+                }
+            }
+            int shift = 0;
+            k = 0;
+            for (unsigned int i = 0; i < _n_node; i++) {
+                if (i == cont) {
+                    shift = 1;
+                    _array[i] = array[i+shift];
+                }
+                else _array[i] = array[i+shift];
+                _in_deg[i] = in_deg[i+shift];
+                _out_deg[i] = out_deg[i+shift];
+                for (unsigned int j = 0; j < _n_node; j++) {
+                    _adjMatrix[i][j] = temp_linear[k];
+                    k++;
+                }
+            }
+        } catch (...) {
+            clear();
+            throw;
+        }
+        // 3. Dealloco quelli vecchi ( con una delete[] )
+        clear();
+        delete[] temp_linear;
+        temp_linear = nullptr;
+        array = _array;
+        adjMatrix = _adjMatrix;
+        in_deg = _in_deg;
+        out_deg = _out_deg;
+        n_node = _n_node;
+        if (rev_index)
+            build_reverse();
+    }
+    
+    /**
+     Metodo per l'inserimento di nuovi archi nel grafo ( matrice di adiacenza ).
+     
+     @brief Metodo per l'inserimento di nuovi archi nel grafo.
+     
+     @param node1 nodo di partenza dell'arco.
+     @param node2 nodo di destinazione dell'arco.
+     
+     @throw eccezione costum si tenta di aggiungere un arco su nodi non esistenti
+     @throw eccezione costum l'arco già esiste
+     
+     */
+    // metodo per aggiungere archi
+    void addEdge(const T &node1, const T &node2) {
+        typename S::timer _op_timer(*this, OP_ADD_EDGE);
+        int count1 = 0;
+        int count2 = 0;
+        if (exists(node1) == false || exists(node2) == false) {  // gestisce il caso in cui si tenta di aggiungere un arco su nodi non esistenti
+            throw error(997);
+        }
+        for (unsigned int i = 0; i < n_node; ++i) {
+            if (eql(array[i], node1))
+                count1 = i;
+        }
+        for (unsigned int j = 0; j < n_node; ++j) {
+            if (eql(array[j], node2))
+                count2 = j;
+        }
+        if (adjMatrix[count1][count2] == true){  // gestisce il caso in cui l'arco già esiste
+            throw error(996);
+        }
+        adjMatrix[count1][count2] = true;
+        ++out_deg[count1];
+        ++in_deg[count2];
+        if (rev_index)
+            revMatrix[count2][count1] = true;
+    }
+    
+    /**
+     Metodo per la rimozione di archi dal grafo ( matrice di adiacenza ).
+     
+     @brief Metodo per la rimozione di archi dal grafo.
+     
+     @param node1 nodo di partenza dell'arco.
+     @param node2 nodo di destinazione dell'arco.
+     
+     @throw eccezione costum si tenta di rimuovere un arco su nodi non esistenti
+     @throw eccezione costum l'arco già non esiste
+     
+     */
+    void removeEdge(const T &node1, const T &node2) {
+        typename S::timer _op_timer(*this, OP_REMOVE_EDGE);
+        int count1 = 0;
+        int count2 = 0;
+        if (exists(node1) == false || exists(node2) == false) {  // gestisce il caso in cui si tenta di rimuovere un arco su nodi non esistenti
+            throw error(995);
+        }
+        for (unsigned int i = 0; i < n_node; ++i) {
+            if (eql(array[i], node1))
+                count1 = i;
+        }
+        for (unsigned int j = 0; j < n_node; ++j) {
+            if (eql(array[j], node2))
+                count2 = j;
+        }
+        if (adjMatrix[count1][count2] != true){  // gestisce il caso in cui l'arco già non esiste
+            throw error(994);
+        }
+        adjMatrix[count1][count2] = false;
+        --out_deg[count1];
+        --in_deg[count2];
+        if (rev_index)
+            revMatrix[count2][count1] = false;
+    }
+    
+    /**
+     Metodo per sapere se esiste un certo nodo nel grafo tramite funtore E _eql.
+     
+     @brief Metodo per sapere se esiste un certo nodo nel grafo.
+     
+     @param node nodo che vogliamo sapere se esiste.
+     
+     @return true se esiste, false altrimenti.
+     
+     */
+    bool exists(const T &node) {
+        typename S::timer _op_timer(*this, OP_EXISTS);
+        for (int i = 0; i < n_node; ++i) {
+            if (eql(array[i], node))
+                return true;
+        }
+        return false;
+    }
+    /**
+     Metodo per sapere se una coppia di nodi è connessa da un arco
+     
+     @brief Metodo per sapere se esiste un certo arco tra due nodi.
+     
+     @param node1 nodo di partenza.
+     @param node2 nodo di destinazione.
+     
+     @throw eccezione custom che gestisce il caso in cui uno o entrambi i nodi non esistano.
+
+     @return true se esiste, false altrimenti.
+     
+     */
+    bool hasEdge(const T &node1, const T &node2) {
+        typename S::timer _op_timer(*this, OP_HAS_EDGE);
+        int count1 = 0;
+        int count2 = 0;
+        if (exists(node1) == false || exists(node2) == false) {
+            throw error(993);
+        }
+        for (unsigned int i = 0; i < n_node; ++i) {
+            if (eql(array[i], node1))
+                count1 = i;
+        }
+        for (unsigned int j = 0; j < n_node; ++j) {
+            if (eql(array[j], node2)) 
+                count2 = j;
+        }
+        if (adjMatrix[count1][count2] == true)
+            return true;
+        return false;
+    }
+    
+    /**
+        Metodo per conoscere il numero di nodi della classe.
+     
+        @brief metodo per conoscere il numero di nodi della classe
+     
+        @return numero di nodi.
+    */
+    int num_nodes() const {
+        return n_node;
+    }
+    
+    /**
+     Metodo per conoscere il numero di archi della classe, come somma dei
+     gradi uscenti mantenuti dal grafo (costo lineare nel numero di nodi).
+     
+     @brief metodo per conoscere il numero di archi della classe
+     
+     @return numero di archi.
+     */
+    int num_edges() const {
+        int cont = 0;
+        for (int i = 0; i < n_node; i++) {
+            cont += out_deg[i];
+        }
+        return cont;
+    }
+    
+    /**
+     Metodo per rimuovere tutti gli archi mantenendo i nodi. Le righe della
+     matrice di adiacenza (e dell'indice inverso) sono azzerate a blocchi da
+     più thread.
+     
+     @brief metodo per rimuovere tutti gli archi
+     
+     @param threads numero di thread (0 = numero di core disponibili).
+     */
+    void clearEdges(unsigned int threads = 1) {
+        const int n = n_node;
+        bool **adj = adjMatrix;
+        bool **rev = revMatrix;
+        parallel_for(0, n, threads, [=](int lo, int hi) {
+            for (int i = lo; i < hi; ++i) {
+                std::memset(adj[i], 0, n * sizeof(bool));
+                if (rev != nullptr)
+                    std::memset(rev[i], 0, n * sizeof(bool));
+            }
+        });
+        for (int i = 0; i < n; ++i) {
+            in_deg[i] = 0;
+            out_deg[i] = 0;
+        }
+    }
+    
+    /**
+     Metodo per conoscere il grado entrante di un nodo. Il grado è mantenuto
+     da addEdge/removeEdge, quindi il costo è quello della ricerca del nodo.
+     
+     @brief metodo per conoscere il grado entrante di un nodo
+     
+     @param node nodo di cui si vuole il grado.
+     
+     @throw eccezione custom se il nodo non esiste
+     
+     @return numero di archi entranti nel nodo.
+     */
+    int inDegree(const T &node) const {
+        int idx = index_of(node);
+        if (idx < 0) {
+            throw error(990);
+        }
+        return in_deg[idx];
+    }
+    
+    /**
+     Metodo per conoscere il grado uscente di un nodo. Il grado è mantenuto
+     da addEdge/removeEdge, quindi il costo è quello della ricerca del nodo.
+     
+     @brief metodo per conoscere il grado uscente di un nodo
+     
+     @param node nodo di cui si vuole il grado.
+     
+     @throw eccezione custom se il nodo non esiste
+     
+     @return numero di archi uscenti dal nodo.
+     */
+    int outDegree(const T &node) const {
+        int idx = index_of(node);
+        if (idx < 0) {
+            throw error(990);
+        }
+        return out_deg[idx];
+    }
+    
+    /**
+     Metodo per esportare in blocco i gradi di tutti i nodi, nell'ordine di
+     iterazione dei nodi.
+     
+     @brief metodo per esportare i gradi di tutti i nodi
+     
+     @param in vettore di output dei gradi entranti.
+     @param out vettore di output dei gradi uscenti.
+     */
+    void degrees(std::vector<int> &in, std::vector<int> &out) const {
+        in.assign(in_deg, in_deg + n_node);
+        out.assign(out_deg, out_deg + n_node);
+    }
+    
+    /**
+     Metodo per calcolare il grafo trasposto (tutti gli archi invertiti). La
+     matrice di adiacenza è trasposta a blocchi per restare in cache.
+     
+     @brief metodo per calcolare il grafo trasposto
+     
+     @throw eccezione allocazione di memoria
+     @throw eccezione copia dei valori
+     
+     @return grafo con gli stessi nodi e gli archi invertiti.
+     */
+    Graph transpose() const {
+        Graph t;
+        t.adjMatrix = new bool*[n_node]();
+        t.array = new T [n_node]();
+        t.in_deg = new int[n_node]();
+        t.out_deg = new int[n_node]();
+        t.n_node = n_node;
+        for (int i = 0; i < n_node; ++i) {
+            t.adjMatrix[i] = new bool[n_node];
+            t.array[i] = array[i];
+            t.in_deg[i] = out_deg[i];
+            t.out_deg[i] = in_deg[i];
+        }
+        if (rev_index) {
+            for (int i = 0; i < n_node; ++i)
+                std::memcpy(t.adjMatrix[i], revMatrix[i], n_node * sizeof(bool));
+        } else {
+            transpose_blocked(adjMatrix, t.adjMatrix, n_node);
+        }
+        return t;
+    }
+    
+    /**
+     Metodo per attivare l'indice inverso: una copia trasposta della matrice
+     di adiacenza mantenuta da tutte le operazioni di modifica, che rende la
+     ricerca dei predecessori di un nodo veloce quanto quella dei successori.
+     Raddoppia la memoria occupata dagli archi.
+     
+     @brief metodo per attivare l'indice inverso
+     
+     @throw eccezione allocazione di memoria
+     */
+    void enableReverseIndex() {
+        if (rev_index)
+            return;
+        rev_index = true;
+        build_reverse();
+    }
+    
+    /**
+     Metodo per disattivare l'indice inverso e liberarne la memoria.
+     
+     @brief metodo per disattivare l'indice inverso
+     */
+    void disableReverseIndex() {
+        free_reverse();
+        rev_index = false;
+    }
+    
+    /**
+     Metodo per sapere se l'indice inverso è attivo.
+     
+     @brief metodo per sapere se l'indice inverso è attivo
+     
+     @return true se l'indice inverso è attivo, false altrimenti.
+     */
+    bool hasReverseIndex() const {
+        return rev_index;
+    }
+    
+    /**
+     Metodo per conoscere i nodi da cui esce un arco verso node. Con l'indice
+     inverso attivo viene letta una riga contigua, altrimenti una colonna
+     della matrice di adiacenza.
+     
+     @brief metodo per conoscere i predecessori di un nodo
+     
+     @param node nodo di destinazione.
+     
+     @throw eccezione custom se il nodo non esiste
+     
+     @return predecessori del nodo, nell'ordine di iterazione dei nodi.
+     */
+    std::vector<T> predecessors(const T &node) const {
+        int idx = index_of(node);
+        if (idx < 0) {
+            throw error(990);
+        }
+        std::vector<T> result;
+        result.reserve(in_deg[idx]);
+        if (rev_index) {
+            const bool *row = revMatrix[idx];
+            for (int i = 0; i < n_node; ++i) {
+                if (row[i])
+                    result.push_back(array[i]);
+            }
+        } else {
+            for (int i = 0; i < n_node; ++i) {
+                if (adjMatrix[i][idx])
+                    result.push_back(array[i]);
+            }
+        }
+        return result;
+    }
+    
+    /**
+     Metodo per conoscere i nodi verso cui esce un arco da node.
+     
+     @brief metodo per conoscere i successori di un nodo
+     
+     @param node nodo di partenza.
+     
+     @throw eccezione custom se il nodo non esiste
+     
+     @return successori del nodo, nell'ordine di iterazione dei nodi.
+     */
+    std::vector<T> successors(const T &node) const {
+        int idx = index_of(node);
+        if (idx < 0) {
+            throw error(990);
+        }
+        std::vector<T> result;
+        result.reserve(out_deg[idx]);
+        const bool *row = adjMatrix[idx];
+        for (int j = 0; j < n_node; ++j) {
+            if (row[j])
+                result.push_back(array[j]);
+        }
+        return result;
+    }
+    
+    /**
+        Struttura che descrive le differenze tra due grafi. Gli archi sono
+        espressi come coppie di indici riferiti all'ordine dei nodi del grafo
+        risultante: prima i nodi sopravvissuti (nell'ordine originale), poi i
+        nodi aggiunti (nell'ordine di added_nodes). Può essere trasmessa ad
+        un altro processo con writePatch e readPatch.
+     
+        @brief Patch incrementale tra due grafi
+     */
+    struct patch {
+        std::vector<T> removed_nodes;                   ///< nodi da rimuovere
+        std::vector<T> added_nodes;                     ///< nodi da aggiungere in coda
+        std::vector<std::pair<int,int> > removed_edges; ///< archi da rimuovere
+        std::vector<std::pair<int,int> > added_edges;   ///< archi da aggiungere
+        
+        // Ritorna true se la patch non contiene modifiche
+        bool empty() const {
+            return removed_nodes.empty() && added_nodes.empty() &&
+                   removed_edges.empty() && added_edges.empty();
+        }
+    };
+    
+    /**
+     Metodo per calcolare la patch che trasforma il grafo corrente in other.
+     Se i nodi comuni compaiono nello stesso ordine le righe della matrice di
+     adiacenza vengono confrontate in blocco e solo quelle diverse sono
+     esaminate cella per cella. Se l'ordine è diverso (ad esempio dopo una
+     rimozione seguita da un inserimento) ogni cella tra nodi comuni viene
+     esaminata: il costo è O(n^2) confronti di celle, più O(n) confronti
+     di nodi per ogni nodo che non è nella stessa posizione in other.
+     
+     @brief Metodo per calcolare le differenze tra due grafi.
+     
+     @param other grafo di destinazione.
+     
+     @return patch da applicare con applyPatch.
+     */
+    patch diff(const Graph &other) const {
+        patch p;
+        // 1. Associo ogni nodo del grafo corrente al nodo uguale in other
+        std::vector<int> map(n_node, -1);
+        std::vector<char> matched(other.n_node, 0);
+        bool aligned = true;
+        for (int i = 0; i < n_node; ++i) {
+            int j = -1;
+            if (i < other.n_node && eql(array[i], other.array[i]))
+                j = i;
+            else
+                j = other.index_of(array[i]);
+            map[i] = j;
+            if (j >= 0)
+                matched[j] = 1;
+            else
+                p.removed_nodes.push_back(array[i]);
+            if (j != i)
+                aligned = false;
+        }
+        // 2. Calcolo la posizione di ogni nodo di other nel grafo risultante
+        std::vector<int> pos(other.n_node, -1);
+        int k = 0;
+        for (int i = 0; i < n_node; ++i) {
+            if (map[i] >= 0)
+                pos[map[i]] = k++;
+        }
+        for (int j = 0; j < other.n_node; ++j) {
+            if (!matched[j]) {
+                p.added_nodes.push_back(other.array[j]);
+                pos[j] = k++;
+            }
+        }
+        // 3. Archi tra nodi comuni
+        for (int i = 0; i < n_node; ++i) {
+            if (map[i] < 0)
+                continue;
+            const bool *row = adjMatrix[i];
+            const bool *orow = other.adjMatrix[map[i]];
+            if (aligned && std::memcmp(row, orow, n_node * sizeof(bool)) == 0)
+                continue;
+            for (int j = 0; j < n_node; ++j) {
+                if (map[j] < 0)
+                    continue;
+                if (row[j] && !orow[map[j]])
+                    p.removed_edges.push_back(std::make_pair(pos[map[i]], pos[map[j]]));
+                else if (!row[j] && orow[map[j]])
+                    p.added_edges.push_back(std::make_pair(pos[map[i]], pos[map[j]]));
+            }
+        }
+        // 4. Archi che coinvolgono nodi nuovi: righe intere dei nodi nuovi,
+        //    colonne dei nodi nuovi per gli altri
+        if (!p.added_nodes.empty()) {
+            std::vector<int> fresh;
+            for (int j = 0; j < other.n_node; ++j) {
+                if (!matched[j])
+                    fresh.push_back(j);
+            }
+            for (int i = 0; i < other.n_node; ++i) {
+                const bool *orow = other.adjMatrix[i];
+                if (!matched[i]) {
+                    for (int j = 0; j < other.n_node; ++j) {
+                        if (orow[j])
+                            p.added_edges.push_back(std::make_pair(pos[i], pos[j]));
+                    }
+                } else {
+                    for (unsigned int f = 0; f < fresh.size(); ++f) {
+                        if (orow[fresh[f]])
+                            p.added_edges.push_back(std::make_pair(pos[i], pos[fresh[f]]));
+                    }
+                }
+            }
+        }
+        return p;
+    }
+    
+    /**
+     Metodo per applicare una patch al grafo. La patch viene validata per
+     intero prima di modificare il grafo; la matrice di adiacenza viene
+     riallocata una sola volta e solo se la patch aggiunge o rimuove nodi.
+     
+     @brief Metodo per applicare una patch al grafo.
+     
+     @param p patch da applicare (tipicamente ottenuta con diff).
+     
+     @throw eccezione custom se un nodo da rimuovere non esiste
+     @throw eccezione custom se un nodo da aggiungere esiste già
+     @throw eccezione custom se un arco da rimuovere non esiste o è ripetuto
+     @throw eccezione custom se un arco da aggiungere esiste già o è ripetuto
+     @throw eccezione custom se un indice di arco non è valido
+     @throw eccezione allocazione di memoria
+     */
+    void applyPatch(const patch &p) {
+        apply_patch(p, true);
+    }
+    
+private:
+    /**
+        Metodo che applica una patch. Con check_added == false i nodi
+        aggiunti non sono confrontati tra loro (O(k^2) confronti per k nodi):
+        il chiamante garantisce che siano distinti, come per i checkpoint di
+        VersionedGraph, che contengono i nodi di un grafo valido.
+     
+        @brief Metodo per applicare una patch al grafo.
+     
+        @param p patch da applicare.
+        @param check_added true per verificare che i nodi aggiunti siano distinti.
+     */
+    void apply_patch(const patch &p, bool check_added) {
+        typename S::timer _op_timer(*this, OP_APPLY_PATCH);
+        // 1. Validazione dei nodi
+        std::vector<char> removed(n_node, 0);
+        for (unsigned int r = 0; r < p.removed_nodes.size(); ++r) {
+            int idx = index_of(p.removed_nodes[r]);
+            if (idx < 0 || removed[idx]) {
+                throw error(998);
+            }
+            removed[idx] = 1;
+        }
+        for (unsigned int a = 0; a < p.added_nodes.size(); ++a) {
+            if (index_of(p.added_nodes[a]) >= 0) {
+                throw error(999);
+            }
+            for (unsigned int b = 0; check_added && b < a; ++b) {
+                if (eql(p.added_nodes[a], p.added_nodes[b]))
+                    throw error(999);
+            }
+        }
+        std::vector<int> keep;
+        keep.reserve(n_node);
+        for (int i = 0; i < n_node; ++i) {
+            if (!removed[i])
+                keep.push_back(i);
+        }
+        const int n_keep = keep.size();
+        const int _n_node = n_keep + p.added_nodes.size();
+        // 2. Validazione degli archi (indici riferiti al grafo risultante)
+        for (unsigned int e = 0; e < p.removed_edges.size(); ++e) {
+            int a = p.removed_edges[e].first;
+            int b = p.removed_edges[e].second;
+            if (a < 0 || b < 0 || a >= _n_node || b >= _n_node) {
+                throw error(992);
+            }
+            if (a >= n_keep || b >= n_keep || adjMatrix[keep[a]][keep[b]] != true) {
+                throw error(994);
+            }
+        }
+        for (unsigned int e = 0; e < p.added_edges.size(); ++e) {
+            int a = p.added_edges[e].first;
+            int b = p.added_edges[e].second;
+            if (a < 0 || b < 0 || a >= _n_node || b >= _n_node) {
+                throw error(992);
+            }
+            if (a < n_keep && b < n_keep && adjMatrix[keep[a]][keep[b]] == true) {
+                throw error(996);
+            }
+        }
+        // un arco ripetuto nella stessa lista altererebbe i gradi
+        std::vector<std::pair<int,int> > sorted(p.removed_edges);
+        std::sort(sorted.begin(), sorted.end());
+        if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end()) {
+            throw error(994);
+        }
+        sorted = p.added_edges;
+        std::sort(sorted.begin(), sorted.end());
+        if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end()) {
+            throw error(996);
+        }
+        // 3. Nodi: una sola riallocazione su un grafo di appoggio
+        if (!p.removed_nodes.empty() || !p.added_nodes.empty()) {
+            count_realloc(_n_node, n_keep);
+            Graph tmp;
+            tmp.adjMatrix = new bool*[_n_node]();
+            tmp.array = new T [_n_node]();
+            tmp.in_deg = new int[_n_node]();
+            tmp.out_deg = new int[_n_node]();
+            tmp.n_node = _n_node;
+            for (int i = 0; i < _n_node; ++i) {
+                tmp.adjMatrix[i] = new bool[_n_node]();
+            }
+            for (int i = 0; i < n_keep; ++i) {
+                tmp.array[i] = array[keep[i]];
+                const bool *row = adjMatrix[keep[i]];
+                bool *_row = tmp.adjMatrix[i];
+                if (n_keep == n_node) {
+                    std::memcpy(_row, row, n_node * sizeof(bool));
+                } else {
+                    for (int j = 0; j < n_keep; ++j)
+                        _row[j] = row[keep[j]];
+                }
+                for (int j = 0; j < n_keep; ++j) {
+                    if (_row[j]) {
+                        ++tmp.out_deg[i];
+                        ++tmp.in_deg[j];
+                    }
+                }
+            }
+            for (unsigned int a = 0; a < p.added_nodes.size(); ++a) {
+                tmp.array[n_keep + a] = p.added_nodes[a];
+            }
+            tmp.rev_index = rev_index;
+            tmp.swap(*this);
+            if (rev_index)
+                build_reverse();
+        }
+        // 4. Archi
+        for (unsigned int e = 0; e < p.removed_edges.size(); ++e) {
+            adjMatrix[p.removed_edges[e].first][p.removed_edges[e].second] = false;
+            --out_deg[p.removed_edges[e].first];
+            --in_deg[p.removed_edges[e].second];
+            if (rev_index)
+                revMatrix[p.removed_edges[e].second][p.removed_edges[e].first] = false;
+        }
+        for (unsigned int e = 0; e < p.added_edges.size(); ++e) {
+            adjMatrix[p.added_edges[e].first][p.added_edges[e].second] = true;
+            ++out_deg[p.added_edges[e].first];
+            ++in_deg[p.added_edges[e].second];
+            if (rev_index)
+                revMatrix[p.added_edges[e].second][p.added_edges[e].first] = true;
+        }
+    }
+    
+public:
+    /**
+     Metodo per scrivere una patch in formato binario compatto, per inviarla
+     ad un altro processo. Tutti i numeri sono varint (come in
+     writeCompressed): per nodi rimossi e aggiunti il numero di nodi seguito
+     dai nodi serializzati con write_node; per archi rimossi e aggiunti il
+     numero di archi seguito dalle coppie ordinate, con la sorgente come
+     distanza dalla precedente e la destinazione come distanza dalla
+     precedente meno uno (o come indice se la sorgente cambia).
+     
+     @brief metodo per serializzare una patch
+     
+     @param p patch da scrivere.
+     @param out stream o file descriptor di destinazione.
+     @param write_node funtore void(graph_writer &, const T &) che scrive un nodo.
+     
+     @throw eccezione custom se la scrittura fallisce
+     */
+    template <typename W>
+    static void writePatch(const patch &p, graph_output out, W write_node) {
+        graph_writer w(out);
+        w.write_varint(p.removed_nodes.size());
+        for (unsigned int i = 0; i < p.removed_nodes.size(); ++i)
+            write_node(w, p.removed_nodes[i]);
+        w.write_varint(p.added_nodes.size());
+        for (unsigned int i = 0; i < p.added_nodes.size(); ++i)
+            write_node(w, p.added_nodes[i]);
+        write_edges(w, p.removed_edges);
+        write_edges(w, p.added_edges);
+        w.flush();
+    }
+    
+    /**
+     Metodo per scrivere una patch in formato binario compatto, serializzando
+     ogni nodo come testo (operatore << di T) preceduto dalla sua lunghezza.
+     
+     @brief metodo per serializzare una patch
+     
+     @param p patch da scrivere.
+     @param out stream o file descriptor di destinazione.
+     
+     @throw eccezione custom se la scrittura fallisce
+     */
+    static void writePatch(const patch &p, graph_output out) {
+        writePatch(p, out, write_text_node);
+    }
+    
+    /**
+     Metodo per leggere una patch scritta con writePatch.
+     
+     @brief metodo per deserializzare una patch
+     
+     @param in stream di origine.
+     @param read_node funtore T(std::istream &) che legge un nodo.
+     
+     @throw eccezione custom se i dati sono troncati o non validi
+     
+     @return patch letta.
+     */
+    template <typename R>
+    static patch readPatch(std::istream &in, R read_node) {
+        patch p;
+        unsigned long long n = read_varint(in);
+        for (unsigned long long i = 0; i < n; ++i)
+            p.removed_nodes.push_back(read_node(in));
+        n = read_varint(in);
+        for (unsigned long long i = 0; i < n; ++i)
+            p.added_nodes.push_back(read_node(in));
+        read_edges(in, p.removed_edges);
+        read_edges(in, p.added_edges);
+        return p;
+    }
+    
+    /**
+     Metodo per leggere una patch scritta con writePatch senza funtore, con
+     i nodi letti dall'operatore >> di T (std::string è copiata per intero).
+     
+     @brief metodo per deserializzare una patch
+     
+     @param in stream di origine.
+     
+     @throw eccezione custom se i dati sono troncati o non validi
+     
+     @return patch letta.
+     */
+    static patch readPatch(std::istream &in) {
+        return readPatch(in, read_text_node);
+    }
+    
+    /**
+     Metodo per calcolare il PageRank dei nodi con il metodo delle potenze.
+     La lista degli archi entranti (formato compresso per righe) è
+     calcolata una sola volta a partire dai gradi mantenuti dal grafo; ad ogni iterazione ogni nodo
+     raccoglie (pull) i contributi dei suoi predecessori. Le righe sono
+     divise a blocchi tra i thread. I nodi senza archi uscenti distribuiscono
+     il loro rank uniformemente su tutti i nodi. La raccolta dei contributi
+     legge contrib attraverso gli indici CSR e resta quindi scalare; solo i
+     cicli contigui sui nodi sono vettorizzabili dal compilatore.
+     
+     @brief Metodo per calcolare il PageRank dei nodi.
+     
+     @param damping fattore di smorzamento, compreso tra 0 e 1.
+     @param tolerance soglia di convergenza sulla norma L1 tra due iterazioni.
+     @param max_iter numero massimo di iterazioni.
+     @param threads numero di thread (0 = numero di core disponibili).
+     
+     @throw eccezione custom se i parametri non sono validi
+     
+     @return vettore dei rank, nell'ordine di iterazione dei nodi.
+     */
+    std::vector<double> pageRank(double damping = 0.85, double tolerance = 1e-9,
+                                 int max_iter = 100, unsigned int threads = 0) const {
+        if (damping < 0 || damping > 1 || tolerance <= 0 || max_iter <= 0) {
+            throw error(991);
+        }
+        const int n = n_node;
+        std::vector<double> rank(n, n > 0 ? 1.0 / n : 0.0);
+        if (n == 0)
+            return rank;
+        // 1. Archi entranti in formato compresso (CSR), dai gradi entranti
+        std::vector<int> in_ptr(n + 1, 0);
+        for (int j = 0; j < n; ++j)
+            in_ptr[j + 1] = in_ptr[j] + in_deg[j];
+        std::vector<int> in_idx(in_ptr[n]);
+        std::vector<int> fill(in_ptr.begin(), in_ptr.end() - 1);
+        for (int i = 0; i < n; ++i) {
+            const bool *row = adjMatrix[i];
+            for (int j = 0; j < n; ++j) {
+                if (row[j])
+                    in_idx[fill[j]++] = i;
+            }
+        }
+        std::vector<double> inv_out(n, 0.0);
+        for (int i = 0; i < n; ++i) {
+            if (out_deg[i] > 0)
+                inv_out[i] = 1.0 / out_deg[i];
+        }
+        // 2. Iterazioni
+        std::vector<double> contrib(n), next(n);
+        for (int it = 0; it < max_iter; ++it) {
+            double dangling = 0;
+            for (int i = 0; i < n; ++i) {
+                contrib[i] = rank[i] * inv_out[i];
+                if (out_deg[i] == 0)
+                    dangling += rank[i];
+            }
+            const double base = (1.0 - damping) / n + damping * dangling / n;
+            const int *ptr = &in_ptr[0];
+            const int *idx = in_idx.empty() ? nullptr : &in_idx[0];
+            const double *c = &contrib[0];
+            double *nx = &next[0];
+            parallel_for(0, n, threads, [=](int lo, int hi) {
+                for (int i = lo; i < hi; ++i) {
+                    double sum = 0;
+                    for (int k = ptr[i]; k < ptr[i + 1]; ++k)
+                        sum += c[idx[k]];
+                    nx[i] = base + damping * sum;
+                }
+            });
+            double delta = 0;
+            for (int i = 0; i < n; ++i)
+                delta += std::fabs(next[i] - rank[i]);
+            rank.swap(next);
+            if (delta < tolerance)
+                break;
+        }
+        return rank;
+    }
+    
+    /**
+     Metodo per calcolare la centralità di grado (entrante e uscente) dei
+     nodi, normalizzata sul numero di nodi meno uno.
+     
+     @brief Metodo per calcolare la centralità di grado dei nodi.
+     
+     @param in vettore di output della centralità entrante.
+     @param out vettore di output della centralità uscente.
+     */
+    void degreeCentrality(std::vector<double> &in, std::vector<double> &out) const {
+        in.assign(n_node, 0.0);
+        out.assign(n_node, 0.0);
+        if (n_node < 2)
+            return;
+        const double norm = 1.0 / (n_node - 1);
+        for (int i = 0; i < n_node; ++i) {
+            in[i] = in_deg[i] * norm;
+            out[i] = out_deg[i] * norm;
+        }
+    }
+    
+    /**
+     Metodo per calcolare un ordinamento dei nodi che migliora la località
+     della matrice di adiacenza. Gli archi sono considerati non orientati:
+     i cappi sono ignorati e una coppia di archi opposti conta come un solo
+     vicino, anche nel grado.
+     ORDER_RCM (Reverse Cuthill-McKee) visita in ampiezza ogni componente a
+     partire da un nodo di grado minimo, con i vicini in ordine di grado
+     crescente, e inverte l'ordine ottenuto; ORDER_BFS visita in ampiezza
+     nell'ordine attuale; ORDER_DEGREE ordina per grado decrescente.
+     
+     @brief metodo per calcolare un ordinamento dei nodi
+     
+     @param order criterio di ordinamento.
+     
+     @return permutazione: perm[k] è l'indice attuale del nodo in posizione k.
+     */
+    std::vector<int> ordering(graph_order order = ORDER_RCM) const {
+        const int n = n_node;
+        std::vector<int> perm;
+        perm.reserve(n);
+        // Liste di adiacenza non orientate, senza cappi e senza duplicati:
+        // il grado è quello del grafo non orientato che viene visitato
+        std::vector<std::vector<int> > nbr = undirected_lists();
+        std::vector<int> deg(n);
+        for (int i = 0; i < n; ++i)
+            deg[i] = nbr[i].size();
+        if (order == ORDER_DEGREE) {
+            for (int i = 0; i < n; ++i)
+                perm.push_back(i);
+            std::stable_sort(perm.begin(), perm.end(), degree_greater(deg));
+            return perm;
+        }
+        std::vector<char> visited(n, 0);
+        std::vector<int> roots;
+        for (int i = 0; i < n; ++i)
+            roots.push_back(i);
+        if (order == ORDER_RCM) {
+            std::stable_sort(roots.begin(), roots.end(), degree_less(deg));
+            for (int i = 0; i < n; ++i)
+                std::stable_sort(nbr[i].begin(), nbr[i].end(), degree_less(deg));
+        }
+        for (int r = 0; r < n; ++r) {
+            if (visited[roots[r]])
+                continue;
+            unsigned int head = perm.size();
+            perm.push_back(roots[r]);
+            visited[roots[r]] = 1;
+            while (head < perm.size()) {
+                const int u = perm[head++];
+                for (unsigned int k = 0; k < nbr[u].size(); ++k) {
+                    const int v = nbr[u][k];
+                    if (!visited[v]) {
+                        visited[v] = 1;
+                        perm.push_back(v);
+                    }
+                }
+            }
+        }
+        if (order == ORDER_RCM)
+            std::reverse(perm.begin(), perm.end());
+        return perm;
+    }
+    
+    /**
+     Metodo per riordinare i nodi secondo una permutazione. Array dei nodi,
+     matrice di adiacenza, gradi e indice inverso sono ricostruiti in un solo
+     passaggio; le ricerche per valore restano valide, cambia solo l'ordine di
+     iterazione dei nodi.
+     
+     @brief metodo per riordinare i nodi secondo una permutazione
+     
+     @param perm permutazione: perm[k] è l'indice attuale del nodo che andrà in posizione k.
+     
+     @throw eccezione custom se perm non è una permutazione dei nodi
+     @throw eccezione allocazione di memoria
+     @throw eccezione copia dei valori
+     */
+    void permute(const std::vector<int> &perm) {
+        if ((int)perm.size() != n_node) {
+            throw error(987);
+        }
+        std::vector<char> seen(n_node, 0);
+        for (int k = 0; k < n_node; ++k) {
+            if (perm[k] < 0 || perm[k] >= n_node || seen[perm[k]]) {
+                throw error(987);
+            }
+            seen[perm[k]] = 1;
+        }
+        count_realloc(n_node, n_node);
+        Graph tmp;
+        tmp.adjMatrix = new bool*[n_node]();
+        tmp.array = new T [n_node]();
+        tmp.in_deg = new int[n_node]();
+        tmp.out_deg = new int[n_node]();
+        tmp.n_node = n_node;
+        for (int k = 0; k < n_node; ++k) {
+            tmp.adjMatrix[k] = new bool[n_node];
+            const bool *row = adjMatrix[perm[k]];
+            bool *_row = tmp.adjMatrix[k];
+            for (int l = 0; l < n_node; ++l)
+                _row[l] = row[perm[l]];
+            tmp.array[k] = array[perm[k]];
+            tmp.in_deg[k] = in_deg[perm[k]];
+            tmp.out_deg[k] = out_deg[perm[k]];
+        }
+        tmp.rev_index = rev_index;
+        tmp.swap(*this);
+        if (rev_index)
+            build_reverse();
+    }
+    
+    /**
+     Metodo per riordinare i nodi in modo da migliorare la località della
+     matrice di adiacenza (vedi ordering e permute).
+     
+     @brief metodo per riordinare i nodi per località
+     
+     @param order criterio di ordinamento.
+     
+     @throw eccezione allocazione di memoria
+     @throw eccezione copia dei valori
+     */
+    void reorder(graph_order order = ORDER_RCM) {
+        permute(ordering(order));
+    }
+    
+    /**
+     Metodo per contare i triangoli del grafo, considerando gli archi come
+     non orientati e ignorando i cappi.
+     
+     @brief metodo per contare i triangoli del grafo
+     
+     @param threads numero di thread (0 = numero di core disponibili).
+     
+     @return numero di triangoli.
+     */
+    long long triangles(unsigned int threads = 0) const {
+        std::vector<long long> tri = local_triangles(threads);
+        long long sum = 0;
+        for (unsigned int i = 0; i < tri.size(); ++i)
+            sum += tri[i];
+        return sum / 3;
+    }
+    
+    /**
+     Metodo per calcolare il coefficiente di clustering locale di ogni nodo:
+     il rapporto tra i triangoli a cui partecipa e le coppie di suoi vicini,
+     considerando gli archi come non orientati e ignorando i cappi. I nodi
+     con meno di due vicini hanno coefficiente 0.
+     
+     @brief metodo per calcolare il coefficiente di clustering dei nodi
+     
+     @param threads numero di thread (0 = numero di core disponibili).
+     
+     @return coefficienti di clustering, nell'ordine di iterazione dei nodi.
+     */
+    std::vector<double> clustering(unsigned int threads = 0) const {
+        std::vector<int> udeg;
+        std::vector<long long> tri = local_triangles(threads, &udeg);
+        std::vector<double> coeff(n_node, 0.0);
+        for (int i = 0; i < n_node; ++i) {
+            const long long d = udeg[i];
+            if (d >= 2)
+                coeff[i] = 2.0 * tri[i] / (d * (d - 1));
+        }
+        return coeff;
+    }
+    
+    /**
+     Metodo per calcolare l'unione di due grafi: i nodi sono quelli del grafo
+     corrente seguiti da quelli presenti solo in other, confrontati per
+     valore; un arco è presente se è presente in almeno uno dei due grafi.
+     
+     @brief metodo per calcolare l'unione di due grafi
+     
+     @param other secondo grafo.
+     
+     @throw eccezione allocazione di memoria
+     @throw eccezione copia dei valori
+     
+     @return grafo unione.
+     */
+    Graph graphUnion(const Graph &other) const {
+        std::vector<T> nodes;
+        std::vector<int> pos, opos;
+        align(other, false, nodes, pos, opos);
+        const int n = nodes.size();
+        const int words = (n + 63) / 64;
+        std::vector<unsigned long long> bits = packed_aligned(pos, n, words);
+        const std::vector<unsigned long long> obits = other.packed_aligned(opos, n, words);
+        for (size_t w = 0; w < bits.size(); ++w)
+            bits[w] |= obits[w];
+        return from_packed(nodes, bits, words);
+    }
+    
+    /**
+     Metodo per calcolare l'intersezione di due grafi: i nodi sono quelli
+     presenti in entrambi, nell'ordine del grafo corrente; un arco è presente
+     se è presente in entrambi i grafi.
+     
+     @brief metodo per calcolare l'intersezione di due grafi
+     
+     @param other secondo grafo.
+     
+     @throw eccezione allocazione di memoria
+     @throw eccezione copia dei valori
+     
+     @return grafo intersezione.
+     */
+    Graph graphIntersection(const Graph &other) const {
+        std::vector<T> nodes;
+        std::vector<int> pos, opos;
+        align(other, true, nodes, pos, opos);
+        const int n = nodes.size();
+        const int words = (n + 63) / 64;
+        std::vector<unsigned long long> bits = packed_aligned(pos, n, words);
+        const std::vector<unsigned long long> obits = other.packed_aligned(opos, n, words);
+        for (size_t w = 0; w < bits.size(); ++w)
+            bits[w] &= obits[w];
+        return from_packed(nodes, bits, words);
+    }
+    
+    /**
+     Metodo per calcolare la differenza di due grafi: i nodi sono quelli del
+     grafo corrente; un arco è presente se è presente nel grafo corrente e non
+     in other.
+     
+     @brief metodo per calcolare la differenza di due grafi
+     
+     @param other grafo da sottrarre.
+     
+     @throw eccezione allocazione di memoria
+     @throw eccezione copia dei valori
+     
+     @return grafo differenza.
+     */
+    Graph graphDifference(const Graph &other) const {
+        std::vector<T> nodes;
+        std::vector<int> pos, opos;
+        align(other, false, nodes, pos, opos);
+        // i nodi presenti solo in other non fanno parte del risultato
+        nodes.resize(n_node);
+        for (unsigned int j = 0; j < opos.size(); ++j) {
+            if (opos[j] >= n_node)
+                opos[j] = -1;
         }
-        
+        const int words = (n_node + 63) / 64;
+        std::vector<unsigned long long> bits = packed_aligned(pos, n_node, words);
+        const std::vector<unsigned long long> obits = other.packed_aligned(opos, n_node, words);
+        for (size_t w = 0; w < bits.size(); ++w)
+            bits[w] &= ~obits[w];
+        return from_packed(nodes, bits, words);
     }
     
     /**
-        @brief Distruttore della classe
+     Metodo per comporre due grafi (prodotto booleano delle matrici di
+     adiacenza): sui nodi dell'unione esiste l'arco a->c se esiste un nodo b
+     con a->b nel grafo corrente e b->c in other.
      
-        Distruttore della classe. Rimuove dallo heap gli array dinamici
-        allocati in precedenza.
+     @brief metodo per comporre due grafi
+     
+     @param other grafo da applicare dopo il grafo corrente.
+     @param threads numero di thread (0 = numero di core disponibili).
+     
+     @throw eccezione allocazione di memoria
+     @throw eccezione copia dei valori
      
+     @return grafo composto.
      */
-    ~Graph() {
-        clear();
-        n_node = 0;
+    Graph compose(const Graph &other, unsigned int threads = 0) const {
+        std::vector<T> nodes;
+        std::vector<int> pos, opos;
+        align(other, false, nodes, pos, opos);
+        const int n = nodes.size();
+        const int words = (n + 63) / 64;
+        const std::vector<unsigned long long> bits = packed_aligned(pos, n, words);
+        const std::vector<unsigned long long> obits = other.packed_aligned(opos, n, words);
+        return from_packed(nodes, multiply(bits, obits, n, words, threads), words);
     }
     
     /**
-        Metodo per la rimozione di tutti i nodi negli array e lasciare la memoria in uno stato consistente.
+     Metodo per calcolare la potenza k-esima della matrice di adiacenza: esiste
+     l'arco a->b se esiste un cammino (anche con nodi ripetuti) di esattamente
+     k archi da a a b. Usa O(log k) prodotti booleani.
      
-        @brief Metodo per lasciare la memoria in uno stato consistente.
+     @brief metodo per calcolare i cammini di lunghezza k
+     
+     @param k lunghezza dei cammini (0 = solo i cappi su ogni nodo).
+     @param threads numero di thread (0 = numero di core disponibili).
+     
+     @throw eccezione custom se k è negativo
+     @throw eccezione allocazione di memoria
+     @throw eccezione copia dei valori
      
+     @return grafo con gli stessi nodi e gli archi dei cammini di lunghezza k.
      */
-    void clear() {
-        for (unsigned int c = 0; c < n_node; c++) {
-            delete[] adjMatrix[c];
+    Graph power(int k, unsigned int threads = 0) const {
+        if (k < 0) {
+            throw error(981);
         }
-        delete[] adjMatrix;
-        delete[] array;
-        array = nullptr;
-        adjMatrix = nullptr;
-        n_node = 0;
+        std::vector<int> pos(n_node);
+        for (int i = 0; i < n_node; ++i)
+            pos[i] = i;
+        const int words = (n_node + 63) / 64;
+        std::vector<unsigned long long> result = matrix_power(packed_aligned(pos, n_node, words), k, words, threads);
+        return from_packed(std::vector<T>(array, array + n_node), result, words);
     }
     
     /**
-        @brief Operatore di assegnamento
+     Metodo per calcolare l'adiacenza a k passi: esiste l'arco a->b se b è
+     raggiungibile da a con un cammino di almeno 1 e al più k archi. Calcolata
+     come A * (I + A)^(k-1) con O(log k) prodotti booleani.
      
-        Operatore di assegnamento che serve per copiare il contenuto di
-        other in *this.
+     @brief metodo per calcolare i nodi raggiungibili in al più k passi
      
-        @param other Graph da copiare
-        @return reference a Graph
+     @param k numero massimo di archi (0 = nessun arco).
+     @param threads numero di thread (0 = numero di core disponibili).
+     
+     @throw eccezione custom se k è negativo
+     @throw eccezione allocazione di memoria
+     @throw eccezione copia dei valori
+     
+     @return grafo con gli stessi nodi e gli archi a->b con b raggiungibile in al più k passi.
      */
-    Graph& operator=(const Graph &other) {
-        if (&other != this) {
-            Graph tmp(other);
-            tmp.swap(*this);
+    Graph kHop(int k, unsigned int threads = 0) const {
+        if (k < 0) {
+            throw error(981);
         }
-        return *this;
+        std::vector<int> pos(n_node);
+        for (int i = 0; i < n_node; ++i)
+            pos[i] = i;
+        const int words = (n_node + 63) / 64;
+        const std::vector<unsigned long long> a = packed_aligned(pos, n_node, words);
+        std::vector<unsigned long long> result((size_t)n_node * words, 0);
+        if (k > 0) {
+            std::vector<unsigned long long> s = a;
+            for (int i = 0; i < n_node; ++i)
+                s[(size_t)i * words + (i >> 6)] |= 1ULL << (i & 63);
+            result = multiply(a, matrix_power(s, k - 1, words, threads), n_node, words, threads);
+        }
+        return from_packed(std::vector<T>(array, array + n_node), result, words);
     }
     
     /**
+     Metodo per colorare il grafo in modo che i due estremi di ogni arco
+     abbiano colori diversi, considerando gli archi come non orientati e
+     ignorando i cappi. I colori sono 0, 1, 2, ... e al più grado massimo + 1.
      
-        Funzione che scambia gli stati interni tra due grafi
+     @brief metodo per la colorazione greedy del grafo
      
-        @brief Funzione di swap dei dati interni tra due grafi
+     @param method algoritmo di colorazione.
+     @param threads numero di thread per COLOR_JONES_PLASSMANN (0 = numero di core disponibili).
      
-        @param other grafo sorgente
+     @throw eccezione allocazione di memoria
+     
+     @return colore di ogni nodo, nell'ordine di iterazione dei nodi.
      */
-    void swap(Graph &other) {
-        std::swap(this->array, other.array);
-        std::swap(this->n_node, other.n_node);
-        std::swap(this->adjMatrix, other.adjMatrix); 
+    std::vector<int> coloring(graph_coloring method = COLOR_DSATUR, unsigned int threads = 0) const {
+        const std::vector<std::vector<int> > nbr = undirected_lists();
+        std::vector<int> deg(n_node);
+        int max_deg = 0;
+        for (int i = 0; i < n_node; ++i) {
+            deg[i] = nbr[i].size();
+            max_deg = std::max(max_deg, deg[i]);
+        }
+        const int words = (max_deg + 1 + 63) / 64;
+        if (method == COLOR_LARGEST_FIRST) {
+            std::vector<int> order(n_node);
+            for (int i = 0; i < n_node; ++i)
+                order[i] = i;
+            std::stable_sort(order.begin(), order.end(), degree_greater(deg));
+            return greedy_coloring(nbr, order, words);
+        }
+        if (method == COLOR_JONES_PLASSMANN)
+            return jones_plassmann_coloring(nbr, words, threads);
+        return dsatur_coloring(nbr, words);
     }
-
+    
     /**
-        Metodo per l'inserimento di nuovi nodi nel grafo utilizzando array di appoggio.
+     Metodo per dividere i nodi in classi di colore: i nodi di una classe
+     non sono collegati da archi (in nessun verso) e possono quindi essere
+     elaborati insieme, ad esempio come un'ondata di lavori paralleli.
      
-        @brief Metodo per l'inserimento di nuovi nodi nel grafo.
+     @brief metodo per dividere i nodi in insiemi senza archi tra loro
      
-        @param node nodo che si vuole aggiungere al grafo.
+     @param method algoritmo di colorazione.
+     @param threads numero di thread per COLOR_JONES_PLASSMANN (0 = numero di core disponibili).
      
-        @throw eccezione custom che gestisce il caso in cui il nodo già esista
-        @throw eccezione copia dei valori
+     @throw eccezione allocazione di memoria
+     @throw eccezione copia dei valori
      
-    */
-    void addNode(const T &node){
-        if (exists(node) == true) {
-            throw customException("Valore non valido!", 999);
-        }
-        int _n_node = n_node + 1;
-        // 1. Creo (alloco) una nuova matrice e un nuovo array con n_node aumentati di +1
-        bool **_adjMatrix = new bool*[_n_node](); // matrice  di appoggio temporaneo
-        T *_array = new T [_n_node]();            //array di appoggio temporaneo
-        for (unsigned int a = 0; a < _n_node; a++) {
-            _adjMatrix[a] = new bool[_n_node]();
-        }
-        try {
-            // 2. Copio i vecchi array in quelli nuovi e aggiungo il nodo nuovo
-            for (unsigned int i = 0; i < n_node; i++) {
-                _array[i] = array[i];
-                for (unsigned int j = 0; j < n_node; j++) {
-                    _adjMatrix[i][j] = adjMatrix[i][j];
-                }
-            }
-            _array[n_node] = node;
-            _adjMatrix[n_node][n_node] = false;
-            
-        } catch (...) {
-            clear();
-            throw;
+     @return nodi di ogni colore, ciascuna classe nell'ordine di iterazione dei nodi.
+     */
+    std::vector<std::vector<T> > colorClasses(graph_coloring method = COLOR_DSATUR, unsigned int threads = 0) const {
+        const std::vector<int> color = coloring(method, threads);
+        std::vector<std::vector<T> > classes;
+        for (int i = 0; i < n_node; ++i) {
+            if (color[i] >= (int)classes.size())
+                classes.resize(color[i] + 1);
+            classes[color[i]].push_back(array[i]);
         }
-        // 3. Dealloco quelli vecchi
-        clear();
-        n_node = _n_node;
-        array = _array;
-        adjMatrix = _adjMatrix;
+        return classes;
     }
     
     /**
-     Metodo per la rimozione di nodi nel grafo utilizzando array di appoggio.
+     Metodo per calcolare un insieme indipendente massimale (nessun nodo può
+     essere aggiunto senza creare un arco interno), considerando gli archi
+     come non orientati e ignorando i cappi. Ad ogni turno entrano
+     nell'insieme, scelti in parallelo, i nodi indecisi di grado minore di
+     tutti i vicini indecisi (a parità, secondo un hash del nodo) e i loro
+     vicini sono esclusi. Il risultato non dipende dal numero di thread.
      
-     @brief Metodo per lla rimozione di nodi nel grafo.
+     @brief metodo per calcolare un insieme indipendente massimale
      
-     @param node nodo che si vuole rimuovere dal grafo.
+     @param threads numero di thread (0 = numero di core disponibili).
      
-     @throw eccezione custom che gestisce il caso in cui il nodo già non esista
+     @throw eccezione allocazione di memoria
      @throw eccezione copia dei valori
      
+     @return nodi dell'insieme, nell'ordine di iterazione dei nodi.
      */
-    void removeNode(const T &node) {
-        if (exists(node) != true) {
-            throw customException("Valore non valido!", 998);
-        }
-        // Gestire il caso in cui si tenti di rimuovere un nodo dal quale entra/esce un arco!
-        for (unsigned int h = 0; h < n_node; h++) {
-            if(hasEdge(node, array[h]) == true) {
-                removeEdge(node, array[h]);
-            }
-            if(hasEdge(array[h], node) == true) {
-                removeEdge(array[h], node);
-            }
-        }
-        int _n_node = n_node - 1;
-        // 1. Creo (alloco) una nuova matrice e un nuovo array con n_node diminuiti di -1
-        bool **_adjMatrix = new bool*[_n_node](); // matrice  di appoggio temporaneo
-        T *_array = new T [_n_node]();            // array di appoggio temporaneo
-        for (unsigned int a = 0; a < _n_node; a++) {
-            _adjMatrix[a] = new bool[_n_node]();
-        }
-        bool* temp_linear = new bool[_n_node * _n_node](); //array temporaneo di appoggio per la copia dei valori nella adjMatrix
-        // 2. Tolgo il nodo da togliere e copio i vecchi array in quelli nuovi
-        int cont = 0;
-        for (unsigned int c = 0; c < n_node; c++) {
-            if (_eql(array[c], node) == true) {
-                cont = c;
-            }
+    std::vector<T> independentSet(unsigned int threads = 0) const {
+        const std::vector<std::vector<int> > nbr = undirected_lists();
+        // 0 = indeciso, 1 = nell'insieme, 2 = escluso
+        std::vector<char> state(n_node, 0), selected(n_node, 0);
+        std::vector<int> active(n_node);
+        std::vector<unsigned long long> prio(n_node);
+        for (int i = 0; i < n_node; ++i) {
+            active[i] = i;
+            prio[i] = node_hash(i);
         }
-        try {
-            int k = 0;
-            for ( int q = 0; q < n_node; q++ ) {
-                for ( int u = 0; u < n_node; u++ ) {
-                    if (q != cont && u != cont) {
-                        temp_linear[k] = adjMatrix[q][u];
-                        k++;
+        while (!active.empty()) {
+            parallel_for(0, active.size(), threads, [&](int lo, int hi) {
+                for (int k = lo; k < hi; ++k) {
+                    const int v = active[k];
+                    const int dv = nbr[v].size();
+                    char sel = 1;
+                    for (unsigned int x = 0; x < nbr[v].size() && sel; ++x) {
+                        const int u = nbr[v][x];
+                        const int du = nbr[u].size();
+                        if (state[u] == 0 && (du < dv || (du == dv && (prio[u] > prio[v] || (prio[u] == prio[v] && u > v)))))
+                            sel = 0;
                     }
+                    selected[k] = sel;
                 }
+            });
+            for (unsigned int k = 0; k < active.size(); ++k) {
+                if (!selected[k])
+                    continue;
+                state[active[k]] = 1;
+                for (unsigned int x = 0; x < nbr[active[k]].size(); ++x)
+                    state[nbr[active[k]][x]] = 2;
             }
-            int shift = 0;
-            k = 0;
-            for (unsigned int i = 0; i < _n_node; i++) {
-                if (i == cont) {
-                    shift = 1;
-                    _array[i] = array[i+shift];
-                }
-                else _array[i] = array[i+shift];
-                for (unsigned int j = 0; j < _n_node; j++) {
-                    _adjMatrix[i][j] = temp_linear[k];
-                    k++;
-                }
+            int kept = 0;
+            for (unsigned int k = 0; k < active.size(); ++k) {
+                if (state[active[k]] == 0)
+                    active[kept++] = active[k];
             }
-        } catch (...) {
-            clear();
-            throw;
+            active.resize(kept);
         }
-        // 3. Dealloco quelli vecchi ( con una delete[] )
-        clear();
-        delete[] temp_linear;
-        temp_linear = nullptr;
-        array = _array;
-        adjMatrix = _adjMatrix;
-        n_node = _n_node;
+        std::vector<T> result;
+        for (int i = 0; i < n_node; ++i) {
+            if (state[i] == 1)
+                result.push_back(array[i]);
+        }
+        return result;
     }
     
     /**
-     Metodo per l'inserimento di nuovi archi nel grafo ( matrice di adiacenza ).
-     
-     @brief Metodo per l'inserimento di nuovi archi nel grafo.
-     
-     @param node1 nodo di partenza dell'arco.
-     @param node2 nodo di destinazione dell'arco.
+     Metodo per ottenere un'istantanea delle statistiche del grafo. Con la
+     politica no_stats tutti i contatori valgono zero.
      
-     @throw eccezione costum si tenta di aggiungere un arco su nodi non esistenti
-     @throw eccezione costum l'arco già esiste
+     @brief metodo per ottenere le statistiche del grafo
      
+     @return copia dei contatori.
      */
-    // metodo per aggiungere archi
-    void addEdge(const T &node1, const T &node2) {
-        int count1 = 0;
-        int count2 = 0;
-        if (exists(node1) == false || exists(node2) == false) {  // gestisce il caso in cui si tenta di aggiungere un arco su nodi non esistenti
-            throw customException("Valore non valido!", 997);
-        }
-        for (unsigned int i = 0; i < n_node; ++i) {
-            if (_eql(array[i], node1))
-                count1 = i;
-        }
-        for (unsigned int j = 0; j < n_node; ++j) {
-            if (_eql(array[j], node2))
-                count2 = j;
-        }
-        if (adjMatrix[count1][count2] == true){  // gestisce il caso in cui l'arco già esiste
-            throw customException("Valore non valido!", 996);
-        }
-        adjMatrix[count1][count2] = true;
+    graph_stats stats() const {
+        return this->stats_get();
     }
     
     /**
-     Metodo per la rimozione di archi dal grafo ( matrice di adiacenza ).
+     Metodo per azzerare le statistiche del grafo.
      
-     @brief Metodo per la rimozione di archi dal grafo.
-     
-     @param node1 nodo di partenza dell'arco.
-     @param node2 nodo di destinazione dell'arco.
+     @brief metodo per azzerare le statistiche del grafo
+     */
+    void resetStats() {
+        this->stats_reset();
+    }
+    
+    /**
+     Metodo per stampare le statistiche del grafo su uno stream.
      
-     @throw eccezione costum si tenta di rimuovere un arco su nodi non esistenti
-     @throw eccezione costum l'arco già non esiste
+     @brief metodo per stampare le statistiche del grafo
      
+     @param os stream di destinazione.
      */
-    void removeEdge(const T &node1, const T &node2) {
-        int count1 = 0;
-        int count2 = 0;
-        if (exists(node1) == false || exists(node2) == false) {  // gestisce il caso in cui si tenta di rimuovere un arco su nodi non esistenti
-            throw customException("Valore non valido!", 995);
-        }
-        for (unsigned int i = 0; i < n_node; ++i) {
-            if (_eql(array[i], node1))
-                count1 = i;
-        }
-        for (unsigned int j = 0; j < n_node; ++j) {
-            if (_eql(array[j], node2))
-                count2 = j;
-        }
-        if (adjMatrix[count1][count2] != true){  // gestisce il caso in cui l'arco già non esiste
-            throw customException("Valore non valido!", 994);
-        }
-        adjMatrix[count1][count2] = false;
+    void dumpStats(std::ostream &os) const {
+        if (S::enabled)
+            this->stats_get().dump(os);
+        else
+            os << "statistiche disabilitate (usare Graph<T, E, collect_stats>)\n";
     }
     
     /**
-     Metodo per sapere se esiste un certo nodo nel grafo tramite funtore E _eql.
-     
-     @brief Metodo per sapere se esiste un certo nodo nel grafo.
+     Metodo per scrivere la matrice di adiacenza, una riga per nodo nel
+     formato "i : 0 1 0 ...". Le righe sono convertite a blocchi direttamente
+     nel buffer di output.
      
-     @param node nodo che vogliamo sapere se esiste.
+     @brief metodo per esportare la matrice di adiacenza
      
-     @return true se esiste, false altrimenti.
+     @param out stream o file descriptor di destinazione.
      
+     @throw eccezione custom se la scrittura fallisce
      */
-    bool exists(const T &node) {
+    void writeMatrix(graph_output out) const {
+        graph_writer w(out);
+        const int block = graph_writer::CAPACITY / 2;
         for (int i = 0; i < n_node; ++i) {
-            if (_eql(array[i], node))
-                return true;
+            w.write_uint(i);
+            w.write(" : ", 3);
+            const bool *row = adjMatrix[i];
+            for (int j = 0; j < n_node; j += block) {
+                const int len = std::min(block, n_node - j);
+                char *p = w.reserve(2 * len);
+                for (int k = 0; k < len; ++k) {
+                    p[2 * k] = row[j + k] ? '1' : '0';
+                    p[2 * k + 1] = ' ';
+                }
+                w.commit(2 * len);
+            }
+            w.put('\n');
         }
-        return false;
+        w.flush();
     }
+    
     /**
-     Metodo per sapere se una coppia di nodi è connessa da un arco
+     Metodo per scrivere la lista degli archi, un arco "sorgente destinazione"
+     per riga. I nodi sono scritti con l'operatore << di T, formattato una
+     sola volta per nodo.
      
-     @brief Metodo per sapere se esiste un certo arco tra due nodi.
-     
-     @param node1 nodo di partenza.
-     @param node2 nodo di destinazione.
+     @brief metodo per esportare la lista degli archi
      
-     @throw eccezione custom che gestisce il caso in cui uno o entrambi i nodi non esistano.
-
-     @return true se esiste, false altrimenti.
+     @param out stream o file descriptor di destinazione.
      
+     @throw eccezione custom se la scrittura fallisce
      */
-    bool hasEdge(const T &node1, const T &node2) {
-        int count1 = 0;
-        int count2 = 0;
-        if (exists(node1) == false || exists(node2) == false) {
-            throw customException("Valore non valido!", 993);
-        }
-        for (unsigned int i = 0; i < n_node; ++i) {
-            if (_eql(array[i], node1))
-                count1 = i;
-        }
-        for (unsigned int j = 0; j < n_node; ++j) {
-            if (_eql(array[j], node2)) 
-                count2 = j;
+    void writeEdgeList(graph_output out) const {
+        std::vector<std::string> labels = node_labels();
+        graph_writer w(out);
+        for (int i = 0; i < n_node; ++i) {
+            const bool *row = adjMatrix[i];
+            for (int j = 0; j < n_node; ++j) {
+                if (row[j]) {
+                    w.write(labels[i]);
+                    w.put(' ');
+                    w.write(labels[j]);
+                    w.put('\n');
+                }
+            }
         }
-        if (adjMatrix[count1][count2] == true)
-            return true;
-        return false;
+        w.flush();
     }
     
     /**
-        Metodo per conoscere il numero di nodi della classe.
+     Metodo per scrivere il grafo in formato DOT (Graphviz). I nodi sono
+     identificati dal loro indice ed etichettati con l'operatore << di T.
      
-        @brief metodo per conoscere il numero di nodi della classe
+     @brief metodo per esportare il grafo in formato DOT
      
-        @return numero di nodi.
-    */
-    int num_nodes() const {
-        return n_node;
+     @param out stream o file descriptor di destinazione.
+     
+     @throw eccezione custom se la scrittura fallisce
+     */
+    void writeDot(graph_output out) const {
+        std::vector<std::string> labels = node_labels();
+        graph_writer w(out);
+        w.write("digraph G {\n", 12);
+        for (int i = 0; i < n_node; ++i) {
+            w.write("  ", 2);
+            w.write_uint(i);
+            w.write(" [label=\"", 9);
+            for (unsigned int c = 0; c < labels[i].size(); ++c) {
+                if (labels[i][c] == '"' || labels[i][c] == '\\')
+                    w.put('\\');
+                w.put(labels[i][c]);
+            }
+            w.write("\"];\n", 4);
+        }
+        for (int i = 0; i < n_node; ++i) {
+            const bool *row = adjMatrix[i];
+            for (int j = 0; j < n_node; ++j) {
+                if (row[j]) {
+                    w.write("  ", 2);
+                    w.write_uint(i);
+                    w.write(" -> ", 4);
+                    w.write_uint(j);
+                    w.write(";\n", 2);
+                }
+            }
+        }
+        w.write("}\n", 2);
+        w.flush();
     }
     
     /**
-     Metodo per conoscere il numero di archi della classe.
+     Metodo per scrivere le liste di adiacenza in formato binario compresso.
+     Tutti i numeri sono varint (7 bit per byte, little endian): il numero di
+     nodi e di archi, poi per ogni nodo il grado uscente seguito dagli indici
+     dei successori codificati come differenze (il primo come indice, i
+     successivi come distanza dal precedente meno uno).
      
-     @brief metodo per conoscere il numero di archi della classe
+     @brief metodo per esportare le liste di adiacenza compresse
      
-     @return numero di archi.
+     @param out stream o file descriptor di destinazione.
+     
+     @throw eccezione custom se la scrittura fallisce
      */
-    int num_edges() const {
-        int cont = 0;
-        for (int i = 0; i < n_node; i++) {
-            for (int j = 0; j < n_node; j++) {
-                if (adjMatrix[i][j] == true)
-                    cont++;
+    void writeCompressed(graph_output out) const {
+        graph_writer w(out);
+        w.write_varint(n_node);
+        w.write_varint(num_edges());
+        for (int i = 0; i < n_node; ++i) {
+            w.write_varint(out_deg[i]);
+            const bool *row = adjMatrix[i];
+            int prev = -1;
+            for (int j = 0; j < n_node; ++j) {
+                if (row[j]) {
+                    w.write_varint(j - prev - 1);
+                    prev = j;
+                }
             }
         }
-        return cont;
+        w.flush();
     }
     
     /**
@@ -422,12 +3077,7 @@ public:
      
      */
     void toString() {
-        for (unsigned int i = 0; i < n_node; i++) {
-            std::cout << i << " : ";
-            for (unsigned int j = 0; j < n_node; j++)
-                std::cout << adjMatrix[i][j] << " ";
-            std::cout << "\n";
-        }
+        writeMatrix(std::cout);
     }
     
     // forward const iterator
@@ -0,0 +1,373 @@
+//
+//  GraphView.hpp
+//
+//
+//  Vista non proprietaria su un sottoinsieme dei nodi di un Graph.
+//
+
+#ifndef GraphView_h
+#define GraphView_h
+
+#include <vector>
+#include <cstring>   // std::memcpy
+#include <iterator>  // std::forward_iterator_tag
+#include <cstddef>   // std::ptrdiff_t
+#include "Graph.hpp"
+
+/**
+    Classe che implementa una vista non proprietaria su un grafo diretto,
+    ristretta ai nodi selezionati da una maschera. La vista espone le stesse
+    interrogazioni del grafo (sul sottografo indotto) senza copiarne i dati.
+    La vista non è più valida se il grafo sottostante viene modificato.
+ 
+    @brief Vista sul sottografo indotto da una maschera di nodi
+ 
+    @param T tipo del dato
+    @param E funtore di comparazione (uguaglianza) tra due dati
+ */
+template <typename T, typename E>
+class GraphView {
+    
+    const Graph<T,E> *graph;  // Grafo sottostante (non posseduto)
+    std::vector<char> mask;   // mask[i] != 0 se il nodo i fa parte della vista
+    int n_node;               // Numero di nodi nella vista
+    
+    /**
+        Metodo per conoscere l'indice nel grafo di un nodo della vista.
+     
+        @brief Metodo per conoscere l'indice di un nodo della vista.
+     
+        @param node nodo da cercare.
+     
+        @return indice del nodo, -1 se il nodo non fa parte della vista.
+     */
+    int index_of(const T &node) const {
+        int idx = graph->index_of(node);
+        if (idx >= 0 && !mask[idx])
+            return -1;
+        return idx;
+    }
+    
+    // Conta i nodi selezionati dalla maschera
+    void count_nodes() {
+        n_node = 0;
+        for (unsigned int i = 0; i < mask.size(); ++i) {
+            if (mask[i])
+                ++n_node;
+        }
+    }
+    
+public:
+    /**
+        @brief Costruttore della vista su tutti i nodi
+     
+        Costruttore per istanziare una vista che contiene tutti i nodi del grafo.
+     
+        @param g grafo sottostante
+     */
+    explicit GraphView(const Graph<T,E> &g) : graph(&g), mask(g.n_node, 1), n_node(g.n_node) {}
+    
+    /**
+        @brief Costruttore della vista da una maschera
+     
+        Costruttore per istanziare una vista a partire da una maschera di nodi
+        allineata all'ordine di iterazione del grafo.
+     
+        @param g grafo sottostante
+        @param m maschera dei nodi, m[i] == true se il nodo i fa parte della vista
+     
+        @throw eccezione custom se la dimensione della maschera non corrisponde
+     */
+    GraphView(const Graph<T,E> &g, const std::vector<bool> &m) : graph(&g), mask(m.begin(), m.end()), n_node(0) {
+        if ((int)m.size() != g.n_node) {
+            throw customException("Valore non valido!", 989);
+        }
+        count_nodes();
+    }
+    
+    /**
+        @brief Costruttore della vista da un predicato
+     
+        Costruttore per istanziare una vista con i nodi del grafo che
+        soddisfano un predicato.
+     
+        @param g grafo sottostante
+        @param pred predicato unario sui nodi
+     */
+    template <typename P>
+    GraphView(const Graph<T,E> &g, P pred) : graph(&g), mask(g.n_node, 0), n_node(0) {
+        for (int i = 0; i < g.n_node; ++i) {
+            if (pred(g.array[i]))
+                mask[i] = 1;
+        }
+        count_nodes();
+    }
+    
+    /**
+     Metodo per sapere se un nodo fa parte della vista.
+     
+     @brief Metodo per sapere se esiste un certo nodo nella vista.
+     
+     @param node nodo che vogliamo sapere se esiste.
+     
+     @return true se esiste, false altrimenti.
+     */
+    bool exists(const T &node) const {
+        return index_of(node) >= 0;
+    }
+    
+    /**
+     Metodo per sapere se una coppia di nodi della vista è connessa da un arco
+     
+     @brief Metodo per sapere se esiste un certo arco tra due nodi della vista.
+     
+     @param node1 nodo di partenza.
+     @param node2 nodo di destinazione.
+     
+     @throw eccezione custom che gestisce il caso in cui uno o entrambi i nodi non siano nella vista.
+     
+     @return true se esiste, false altrimenti.
+     */
+    bool hasEdge(const T &node1, const T &node2) const {
+        int count1 = index_of(node1);
+        int count2 = index_of(node2);
+        if (count1 < 0 || count2 < 0) {
+            throw customException("Valore non valido!", 993);
+        }
+        return graph->adjMatrix[count1][count2];
+    }
+    
+    /**
+        Metodo per conoscere il numero di nodi della vista.
+     
+        @brief metodo per conoscere il numero di nodi della vista
+     
+        @return numero di nodi.
+     */
+    int num_nodes() const {
+        return n_node;
+    }
+    
+    /**
+     Metodo per conoscere il numero di archi tra nodi della vista.
+     
+     @brief metodo per conoscere il numero di archi della vista
+     
+     @return numero di archi.
+     */
+    int num_edges() const {
+        int cont = 0;
+        for (int i = 0; i < graph->n_node; i++) {
+            if (!mask[i])
+                continue;
+            const bool *row = graph->adjMatrix[i];
+            for (int j = 0; j < graph->n_node; j++) {
+                cont += (row[j] & (mask[j] != 0));
+            }
+        }
+        return cont;
+    }
+    
+    /**
+     Metodo per conoscere il grado entrante di un nodo nel sottografo.
+     
+     @brief metodo per conoscere il grado entrante di un nodo della vista
+     
+     @param node nodo di cui si vuole il grado.
+     
+     @throw eccezione custom se il nodo non fa parte della vista
+     
+     @return numero di archi entranti provenienti da nodi della vista.
+     */
+    int inDegree(const T &node) const {
+        int idx = index_of(node);
+        if (idx < 0) {
+            throw customException("Valore non valido!", 990);
+        }
+        int cont = 0;
+        for (int i = 0; i < graph->n_node; i++) {
+            if (mask[i] && graph->adjMatrix[i][idx])
+                cont++;
+        }
+        return cont;
+    }
+    
+    /**
+     Metodo per conoscere il grado uscente di un nodo nel sottografo.
+     
+     @brief metodo per conoscere il grado uscente di un nodo della vista
+     
+     @param node nodo di cui si vuole il grado.
+     
+     @throw eccezione custom se il nodo non fa parte della vista
+     
+     @return numero di archi uscenti verso nodi della vista.
+     */
+    int outDegree(const T &node) const {
+        int idx = index_of(node);
+        if (idx < 0) {
+            throw customException("Valore non valido!", 990);
+        }
+        const bool *row = graph->adjMatrix[idx];
+        int cont = 0;
+        for (int j = 0; j < graph->n_node; j++) {
+            cont += (row[j] & (mask[j] != 0));
+        }
+        return cont;
+    }
+    
+    /**
+     Metodo per estrarre il sottografo indotto in un nuovo grafo. Le colonne
+     selezionate sono raggruppate in intervalli contigui, copiati per ogni
+     riga con una sola memcpy ciascuno.
+     
+     @brief metodo per estrarre il sottografo indotto
+     
+     @throw eccezione allocazione di memoria
+     @throw eccezione copia dei valori
+     
+     @return grafo con i soli nodi (e archi) della vista.
+     */
+    Graph<T,E> materialize() const {
+        // 1. Intervalli contigui di nodi selezionati [first, second)
+        std::vector<std::pair<int,int> > runs;
+        for (int i = 0; i < graph->n_node; ) {
+            if (!mask[i]) {
+                ++i;
+                continue;
+            }
+            int j = i;
+            while (j < graph->n_node && mask[j])
+                ++j;
+            runs.push_back(std::make_pair(i, j));
+            i = j;
+        }
+        // 2. Copia delle righe selezionate, a intervalli
+        Graph<T,E> sub;
+        sub.adjMatrix = new bool*[n_node]();
+        sub.array = new T [n_node]();
+        sub.in_deg = new int[n_node]();
+        sub.out_deg = new int[n_node]();
+        sub.n_node = n_node;
+        int r = 0;
+        for (unsigned int a = 0; a < runs.size(); ++a) {
+            for (int i = runs[a].first; i < runs[a].second; ++i, ++r) {
+                sub.adjMatrix[r] = new bool[n_node];
+                sub.array[r] = graph->array[i];
+                const bool *row = graph->adjMatrix[i];
+                bool *_row = sub.adjMatrix[r];
+                int c = 0;
+                for (unsigned int b = 0; b < runs.size(); ++b) {
+                    int len = runs[b].second - runs[b].first;
+                    std::memcpy(_row + c, row + runs[b].first, len * sizeof(bool));
+                    c += len;
+                }
+            }
+        }
+        // 3. Gradi del sottografo
+        for (int i = 0; i < n_node; ++i) {
+            const bool *row = sub.adjMatrix[i];
+            for (int j = 0; j < n_node; ++j) {
+                if (row[j]) {
+                    ++sub.out_deg[i];
+                    ++sub.in_deg[j];
+                }
+            }
+        }
+        return sub;
+    }
+    
+    // forward const iterator sui nodi della vista
+    class const_iterator; // forward declaration
+    class const_iterator {
+        const GraphView *view;
+        int idx;
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T                         value_type;
+        typedef ptrdiff_t                 difference_type;
+        typedef const T*                  pointer;
+        typedef const T&                  reference;
+        
+        
+        const_iterator() : view(nullptr), idx(0) {}
+        
+        const_iterator(const const_iterator &other) : view(other.view), idx(other.idx) {
+        }
+        
+        const_iterator& operator=(const const_iterator &other) {
+            view = other.view;
+            idx = other.idx;
+            return *this;
+        }
+        
+        ~const_iterator() {
+            
+        }
+        
+        // Ritorna il dato riferito dall'iteratore (dereferenziamento)
+        reference operator*() const {
+            return view->graph->array[idx];
+        }
+        
+        // Ritorna il puntatore al dato riferito dall'iteratore
+        pointer operator->() const {
+            return &(view->graph->array[idx]);
+        }
+        
+        // Operatore di iterazione post-incremento
+        const_iterator operator++(int) {
+            const_iterator tmp(*this);
+            advance();
+            return tmp;
+        }
+        
+        // Operatore di iterazione pre-incremento
+        const_iterator& operator++() {
+            advance();
+            return *this;
+        }
+        
+        // Uguaglianza
+        bool operator==(const const_iterator &other) const {
+            return (view == other.view && idx == other.idx);
+        }
+        
+        // Diversita'
+        bool operator!=(const const_iterator &other) const {
+            return !(*this == other);
+        }
+        
+    private:
+        friend class GraphView;
+        
+        // Costruttore privato di inizializzazione usato dalla vista
+        const_iterator(const GraphView *v, int i) : view(v), idx(i) {
+            skip();
+        }
+        
+        // Salta i nodi esclusi dalla maschera
+        void skip() {
+            while (idx < view->graph->n_node && !view->mask[idx])
+                ++idx;
+        }
+        
+        void advance() {
+            ++idx;
+            skip();
+        }
+        
+    }; // classe const_iterator
+    
+    // Ritorna l'iteratore al primo nodo della vista
+    const_iterator begin() const {
+        return const_iterator(this, 0);
+    }
+    
+    // Ritorna l'iteratore alla fine dei nodi della vista
+    const_iterator end() const {
+        return const_iterator(this, graph->n_node);
+    }
+};
+
+#endif /* GraphView_h */
@@ -0,0 +1,565 @@
+//
+//  InternedGraph.hpp
+//
+//
+//  Grafo con nodi internati in identificatori interi densi e attributi
+//  dei nodi memorizzati per colonne.
+//
+
+#ifndef InternedGraph_h
+#define InternedGraph_h
+
+#include <vector>
+#include <functional> // std::hash
+#include <algorithm>  // std::swap
+#include "Graph.hpp"
+
+/**
+    Tabella hash (indirizzamento aperto, scansione lineare) che associa ad
+    ogni chiave di tipo T un identificatore intero denso: gli identificatori
+    in uso sono sempre 0..size()-1. Quando una chiave viene rimossa, la
+    chiave con l'identificatore più alto prende il suo identificatore.
+ 
+    @brief Tabella di internamento delle chiavi
+ 
+    @param T tipo della chiave
+    @param E funtore di comparazione (uguaglianza) tra due chiavi
+    @param H funtore di hash sulle chiavi
+ */
+template <typename T, typename E, typename H = std::hash<T> >
+class InternTable {
+    
+    enum {
+        EMPTY = -1,    // Slot mai usato
+        DELETED = -2   // Slot di una chiave rimossa
+    };
+    
+    std::vector<T> keys;         // Chiave di ogni identificatore
+    std::vector<int> slots;      // Tabella hash: identificatore, EMPTY o DELETED
+    int n_used;                  // Slot occupati da una chiave
+    int n_deleted;               // Slot marcati DELETED
+    H _hash;                     // Istanza del funtore di hash
+    E _eql;                      // Istanza del funtore di uguaglianza
+    
+    /**
+        Metodo per cercare lo slot di una chiave.
+     
+        @brief Metodo per cercare lo slot di una chiave.
+     
+        @param key chiave da cercare.
+        @param insert_at se non nullo, riceve il primo slot libero incontrato.
+     
+        @return slot della chiave, -1 se la chiave non esiste.
+     */
+    int find_slot(const T &key, int *insert_at) const {
+        if (slots.empty())
+            return -1;
+        const size_t mask = slots.size() - 1;
+        size_t s = _hash(key) & mask;
+        int first_free = -1;
+        for (;;) {
+            const int id = slots[s];
+            if (id == EMPTY) {
+                if (insert_at != nullptr)
+                    *insert_at = first_free >= 0 ? first_free : (int)s;
+                return -1;
+            }
+            if (id == DELETED) {
+                if (first_free < 0)
+                    first_free = s;
+            } else if (_eql(keys[id], key)) {
+                return s;
+            }
+            s = (s + 1) & mask;
+        }
+    }
+    
+    // Ricostruisce la tabella hash con almeno size slot (potenza di 2)
+    void rehash(size_t size) {
+        size_t cap = 16;
+        while (cap < size)
+            cap <<= 1;
+        std::vector<int> fresh(cap, (int)EMPTY);
+        for (unsigned int id = 0; id < keys.size(); ++id) {
+            size_t s = _hash(keys[id]) & (cap - 1);
+            while (fresh[s] != EMPTY)
+                s = (s + 1) & (cap - 1);
+            fresh[s] = id;
+        }
+        slots.swap(fresh);
+        n_deleted = 0;
+    }
+    
+public:
+    InternTable() : n_used(0), n_deleted(0) {}
+    
+    /**
+     Metodo per conoscere l'identificatore di una chiave.
+     
+     @brief Metodo per cercare una chiave.
+     
+     @param key chiave da cercare.
+     
+     @return identificatore della chiave, -1 se la chiave non esiste.
+     */
+    int find(const T &key) const {
+        int s = find_slot(key, nullptr);
+        return s < 0 ? -1 : slots[s];
+    }
+    
+    /**
+     Metodo per internare una chiave: ritorna l'identificatore esistente o
+     ne assegna uno nuovo.
+     
+     @brief Metodo per internare una chiave.
+     
+     @param key chiave da internare.
+     @param inserted se non nullo, riceve true se la chiave è stata aggiunta.
+     
+     @return identificatore della chiave.
+     */
+    int intern(const T &key, bool *inserted = nullptr) {
+        if ((size_t)(n_used + n_deleted + 1) * 4 > slots.size() * 3)
+            rehash((n_used + 1) * 2);
+        int at = -1;
+        int s = find_slot(key, &at);
+        if (inserted != nullptr)
+            *inserted = (s < 0);
+        if (s >= 0)
+            return slots[s];
+        const int id = keys.size();
+        keys.push_back(key);
+        if (slots[at] == DELETED)
+            --n_deleted;
+        slots[at] = id;
+        ++n_used;
+        return id;
+    }
+    
+    /**
+     Metodo per rimuovere una chiave. La chiave con l'identificatore più
+     alto, se diversa, prende l'identificatore della chiave rimossa.
+     
+     @brief Metodo per rimuovere una chiave.
+     
+     @param key chiave da rimuovere.
+     
+     @return identificatore rimosso, -1 se la chiave non esiste.
+     */
+    int erase(const T &key) {
+        int s = find_slot(key, nullptr);
+        if (s < 0)
+            return -1;
+        const int id = slots[s];
+        slots[s] = DELETED;
+        ++n_deleted;
+        --n_used;
+        const int last = keys.size() - 1;
+        if (id != last) {
+            slots[find_slot(keys[last], nullptr)] = id;
+            keys[id] = keys[last];
+        }
+        keys.pop_back();
+        return id;
+    }
+    
+    // Ritorna la chiave di un identificatore in uso
+    const T &key(int id) const {
+        return keys[id];
+    }
+    
+    // Ritorna il numero di chiavi internate
+    int size() const {
+        return n_used;
+    }
+    
+    // Ritorna il numero di identificatori assegnati (uguale a size())
+    int capacity() const {
+        return keys.size();
+    }
+};
+
+/**
+    Interfaccia comune delle colonne di attributi, usata dal grafo per
+    ridimensionarle e copiarle senza conoscerne il tipo.
+ 
+    @brief Colonna di attributi dei nodi (interfaccia)
+ */
+class node_column_base {
+public:
+    virtual ~node_column_base() {}
+    virtual void resize(int n) = 0;
+    virtual void reset(int id) = 0;
+    virtual void move(int from, int to) = 0;
+    virtual node_column_base *clone() const = 0;
+};
+
+/**
+    Colonna contigua di attributi di tipo V, indicizzata dall'identificatore
+    del nodo (struct-of-arrays): gli algoritmi che leggono un solo attributo
+    scorrono un array denso di V.
+ 
+    @brief Colonna di attributi dei nodi
+ 
+    @param V tipo dell'attributo
+ */
+template <typename V>
+class node_column : public node_column_base {
+    std::vector<V> values;  // Valore dell'attributo per ogni identificatore
+    V init;                 // Valore iniziale dei nuovi nodi
+public:
+    explicit node_column(const V &initial) : init(initial) {}
+    
+    void resize(int n) {
+        values.resize(n, init);
+    }
+    
+    void reset(int id) {
+        values[id] = init;
+    }
+    
+    void move(int from, int to) {
+        values[to] = values[from];
+    }
+    
+    node_column_base *clone() const {
+        return new node_column(*this);
+    }
+    
+    // Accesso all'attributo del nodo con identificatore id
+    V &operator[](int id) {
+        return values[id];
+    }
+    
+    const V &operator[](int id) const {
+        return values[id];
+    }
+    
+    // Puntatore ai valori contigui, per scansioni vettoriali
+    const V *data() const {
+        return values.empty() ? nullptr : &values[0];
+    }
+    
+    int size() const {
+        return values.size();
+    }
+};
+
+/**
+    Funtore di uguaglianza tra identificatori interi.
+ 
+    @brief Funtore di uguaglianza tra identificatori
+ */
+struct id_equal {
+    bool operator()(int a, int b) const {
+        return a == b;
+    }
+};
+
+/**
+    Classe che implementa un grafo diretto con chiavi di tipo T internate in
+    identificatori interi densi. Le chiavi sono confrontate solo dalla
+    tabella hash; la struttura del grafo è un Graph<int, id_equal> sugli
+    identificatori, su cui tutti gli algoritmi lavorano con soli interi.
+    Gli attributi dei nodi sono colonne separate indicizzate per
+    identificatore.
+ 
+    L'identificatore di un nodo coincide sempre con la sua posizione in
+    structure(): i risultati per posizione degli algoritmi di Graph
+    (pageRank, degrees, clustering, coloring, ...) sono allineati alle
+    colonne. Per mantenere gli identificatori densi, la rimozione di un
+    nodo assegna il suo identificatore al nodo con l'identificatore più
+    alto. Gli archi sono letti e scritti direttamente nella matrice di
+    adiacenza, in tempo costante, e la matrice cresce geometricamente senza
+    confrontare nodi.
+ 
+    @brief Grafo diretto con chiavi internate e attributi per colonne
+ 
+    @param T tipo della chiave
+    @param E funtore di comparazione (uguaglianza) tra due chiavi
+    @param H funtore di hash sulle chiavi
+ */
+template <typename T, typename E, typename H = std::hash<T> >
+class InternedGraph {
+    
+    InternTable<T,E,H> table;                 // Chiavi -> identificatori
+    Graph<int, id_equal> ids;                 // Struttura del grafo sugli identificatori
+    std::vector<node_column_base*> columns;   // Colonne di attributi (possedute)
+    
+    // Identificatore di una chiave esistente, altrimenti eccezione code
+    int require(const T &key, int code) const {
+        int id = table.find(key);
+        if (id < 0) {
+            throw customException("Valore non valido!", code);
+        }
+        return id;
+    }
+    
+public:
+    /**
+        @brief Costruttore di default
+     
+        Costruttore di default per istanziare un grafo vuoto.
+     */
+    InternedGraph() {}
+    
+    /**
+        @brief Copy constructor
+     
+        Costruttore di copia: copia tabella, struttura e colonne.
+     
+        @param other grafo da copiare
+        @throw eccezione allocazione di memoria
+     */
+    InternedGraph(const InternedGraph &other) : table(other.table), ids(other.ids) {
+        try {
+            for (unsigned int c = 0; c < other.columns.size(); ++c)
+                columns.push_back(other.columns[c]->clone());
+        } catch (...) {
+            for (unsigned int c = 0; c < columns.size(); ++c)
+                delete columns[c];
+            throw;
+        }
+    }
+    
+    /**
+        @brief Distruttore della classe
+     
+        Distruttore della classe. Libera le colonne di attributi.
+     */
+    ~InternedGraph() {
+        for (unsigned int c = 0; c < columns.size(); ++c)
+            delete columns[c];
+    }
+    
+    /**
+        @brief Operatore di assegnamento
+     
+        @param other grafo da copiare
+        @return reference a InternedGraph
+     */
+    InternedGraph &operator=(const InternedGraph &other) {
+        if (&other != this) {
+            InternedGraph tmp(other);
+            tmp.swap(*this);
+        }
+        return *this;
+    }
+    
+    /**
+        @brief Funzione di swap dei dati interni tra due grafi
+     
+        @param other grafo sorgente
+     */
+    void swap(InternedGraph &other) {
+        std::swap(table, other.table);
+        ids.swap(other.ids);
+        columns.swap(other.columns);
+    }
+    
+    /**
+     Metodo per aggiungere una colonna di attributi dei nodi. La colonna è
+     posseduta dal grafo e resta valida finché esiste il grafo.
+     
+     @brief Metodo per aggiungere una colonna di attributi.
+     
+     @param initial valore dell'attributo per i nodi nuovi.
+     
+     @return riferimento alla colonna, indicizzata per identificatore.
+     */
+    template <typename V>
+    node_column<V> &addColumn(const V &initial = V()) {
+        node_column<V> *col = new node_column<V>(initial);
+        try {
+            col->resize(table.capacity());
+            columns.push_back(col);
+        } catch (...) {
+            delete col;
+            throw;
+        }
+        return *col;
+    }
+    
+    /**
+     Metodo per aggiungere un nodo.
+     
+     @brief Metodo per l'inserimento di nuovi nodi nel grafo.
+     
+     @param node chiave del nodo.
+     
+     @throw eccezione custom se il nodo esiste già
+     
+     @return identificatore assegnato al nodo.
+     */
+    int addNode(const T &node) {
+        if (table.find(node) >= 0) {
+            throw customException("Valore non valido!", 999);
+        }
+        int id = table.intern(node);
+        try {
+            ids.append_position(id);
+            for (unsigned int c = 0; c < columns.size(); ++c) {
+                columns[c]->resize(table.capacity());
+                columns[c]->reset(id);
+            }
+        } catch (...) {
+            if (ids.n_node > id)
+                ids.remove_position(id);
+            table.erase(node);
+            throw;
+        }
+        return id;
+    }
+    
+    /**
+     Metodo per rimuovere un nodo e i suoi archi. Il nodo con
+     l'identificatore più alto, se diverso, prende l'identificatore del nodo
+     rimosso (con i suoi archi e i suoi attributi).
+     
+     @brief Metodo per la rimozione di nodi dal grafo.
+     
+     @param node chiave del nodo.
+     
+     @throw eccezione custom se il nodo non esiste
+     */
+    void removeNode(const T &node) {
+        const int id = require(node, 998);
+        const int last = table.capacity() - 1;
+        ids.remove_position(id);
+        if (id < ids.n_node)
+            ids.array[id] = id;  // il nodo spostato prende il valore della sua posizione
+        table.erase(node);
+        for (unsigned int c = 0; c < columns.size(); ++c) {
+            if (id != last)
+                columns[c]->move(last, id);
+            columns[c]->resize(last);
+        }
+    }
+    
+    /**
+     Metodo per aggiungere un arco.
+     
+     @brief Metodo per l'inserimento di nuovi archi nel grafo.
+     
+     @param node1 nodo di partenza dell'arco.
+     @param node2 nodo di destinazione dell'arco.
+     
+     @throw eccezione custom se uno dei nodi non esiste o l'arco esiste già
+     */
+    void addEdge(const T &node1, const T &node2) {
+        const int a = require(node1, 997);
+        const int b = require(node2, 997);
+        if (ids.adjMatrix[a][b]) {
+            throw customException("Valore non valido!", 996);
+        }
+        ids.adjMatrix[a][b] = true;
+        ++ids.out_deg[a];
+        ++ids.in_deg[b];
+    }
+    
+    /**
+     Metodo per rimuovere un arco.
+     
+     @brief Metodo per la rimozione di archi dal grafo.
+     
+     @param node1 nodo di partenza dell'arco.
+     @param node2 nodo di destinazione dell'arco.
+     
+     @throw eccezione custom se uno dei nodi non esiste o l'arco non esiste
+     */
+    void removeEdge(const T &node1, const T &node2) {
+        const int a = require(node1, 995);
+        const int b = require(node2, 995);
+        if (!ids.adjMatrix[a][b]) {
+            throw customException("Valore non valido!", 994);
+        }
+        ids.adjMatrix[a][b] = false;
+        --ids.out_deg[a];
+        --ids.in_deg[b];
+    }
+    
+    /**
+     Metodo per sapere se esiste un nodo (una ricerca nella tabella hash).
+     
+     @brief Metodo per sapere se esiste un certo nodo nel grafo.
+     
+     @param node chiave del nodo.
+     
+     @return true se esiste, false altrimenti.
+     */
+    bool exists(const T &node) const {
+        return table.find(node) >= 0;
+    }
+    
+    /**
+     Metodo per sapere se una coppia di nodi è connessa da un arco.
+     
+     @brief Metodo per sapere se esiste un certo arco tra due nodi.
+     
+     @param node1 nodo di partenza.
+     @param node2 nodo di destinazione.
+     
+     @throw eccezione custom se uno o entrambi i nodi non esistono
+     
+     @return true se esiste, false altrimenti.
+     */
+    bool hasEdge(const T &node1, const T &node2) const {
+        return ids.adjMatrix[require(node1, 993)][require(node2, 993)];
+    }
+    
+    /**
+     Metodo per conoscere l'identificatore di un nodo.
+     
+     @brief Metodo per conoscere l'identificatore di un nodo.
+     
+     @param node chiave del nodo.
+     
+     @return identificatore del nodo, -1 se il nodo non esiste.
+     */
+    int id(const T &node) const {
+        return table.find(node);
+    }
+    
+    /**
+     Metodo per conoscere la chiave di un identificatore in uso.
+     
+     @brief Metodo per conoscere la chiave di un nodo.
+     
+     @param id identificatore del nodo.
+     
+     @return chiave del nodo.
+     */
+    const T &key(int id) const {
+        return table.key(id);
+    }
+    
+    /**
+     Metodo per accedere alla struttura del grafo sugli identificatori, su
+     cui eseguire gli algoritmi di Graph. Il nodo in posizione i ha
+     identificatore (e valore) i.
+     
+     @brief Metodo per accedere al grafo degli identificatori.
+     
+     @return riferimento costante al grafo degli identificatori.
+     */
+    const Graph<int, id_equal> &structure() const {
+        return ids;
+    }
+    
+    // Numero di nodi del grafo
+    int num_nodes() const {
+        return ids.num_nodes();
+    }
+    
+    // Numero di archi del grafo
+    int num_edges() const {
+        return ids.num_edges();
+    }
+    
+    // Numero di identificatori (0..id_capacity()-1), dimensione delle colonne
+    int id_capacity() const {
+        return table.capacity();
+    }
+};
+
+#endif /* InternedGraph_h */
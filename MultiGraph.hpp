@@ -0,0 +1,431 @@
+//
+//  MultiGraph.hpp
+//
+//
+//  Grafo diretto con archi multipli e attributi degli archi per colonne.
+//
+
+#ifndef MultiGraph_h
+#define MultiGraph_h
+
+#include <vector>
+#include <limits>    // std::numeric_limits
+#include <algorithm> // std::max
+#include "Graph.hpp"
+
+/**
+    Classe che implementa un grafo diretto con archi multipli (paralleli)
+    tra la stessa coppia di nodi. Gli archi sono una lista sparsa indicizzata
+    (sorgente, destinazione) e ogni attributo è una colonna di long long
+    allineata alla lista; la matrice di adiacenza del Graph sottostante vale
+    true se esiste almeno un arco tra la coppia di nodi.
+ 
+    Gli indici degli archi sono densi: rimuovendo un arco l'ultimo arco
+    prende il suo indice. Dopo compact() gli archi uscenti da ogni nodo sono
+    contigui e le aggregazioni scorrono porzioni contigue delle colonne.
+ 
+    @brief Grafo diretto con archi multipli e attributi degli archi
+ 
+    @param T tipo del dato
+    @param E funtore di comparazione (uguaglianza) tra due dati
+ */
+template <typename T, typename E>
+class MultiGraph {
+    
+    Graph<T,E> graph;                              // Nodi e adiacenza (almeno un arco)
+    std::vector<int> src;                          // Nodo di partenza di ogni arco
+    std::vector<int> dst;                          // Nodo di arrivo di ogni arco
+    std::vector<std::vector<long long> > columns;  // Colonne degli attributi
+    std::vector<long long> initial;                // Valore iniziale di ogni colonna
+    std::vector<std::vector<int> > out_edges;      // Archi uscenti da ogni nodo
+    std::vector<int> offset;                       // Inizio degli archi di ogni nodo (se compatti)
+    bool compacted;                                // true se gli archi sono ordinati per sorgente
+    
+    // Indice di un nodo esistente, altrimenti eccezione code
+    int require(const T &node, int code) const {
+        int idx = graph.index_of(node);
+        if (idx < 0) {
+            throw customException("Valore non valido!", code);
+        }
+        return idx;
+    }
+    
+    // Verifica che l'indice di arco sia valido
+    void check_edge(int edge) const {
+        if (edge < 0 || edge >= (int)src.size()) {
+            throw customException("Valore non valido!", 985);
+        }
+    }
+    
+    // Verifica che l'indice di colonna sia valido
+    void check_column(int col) const {
+        if (col < 0 || col >= (int)columns.size()) {
+            throw customException("Valore non valido!", 985);
+        }
+    }
+    
+    // Sostituisce old_id con new_id nella lista degli archi uscenti da node
+    void relabel(int node, int old_id, int new_id) {
+        std::vector<int> &list = out_edges[node];
+        for (unsigned int k = 0; k < list.size(); ++k) {
+            if (list[k] == old_id) {
+                if (new_id < 0) {
+                    list[k] = list.back();
+                    list.pop_back();
+                } else {
+                    list[k] = new_id;
+                }
+                return;
+            }
+        }
+    }
+    
+    // Numero di archi da a a b (indici dei nodi)
+    int multiplicity_at(int a, int b) const {
+        int count = 0;
+        const std::vector<int> &list = out_edges[a];
+        for (unsigned int k = 0; k < list.size(); ++k) {
+            if (dst[list[k]] == b)
+                ++count;
+        }
+        return count;
+    }
+    
+public:
+    /**
+        @brief Costruttore di default
+     
+        Costruttore di default per istanziare un grafo vuoto.
+     */
+    MultiGraph() : offset(1, 0), compacted(true) {}
+    
+    /**
+     Metodo per aggiungere una colonna di attributi degli archi.
+     
+     @brief Metodo per aggiungere una colonna di attributi.
+     
+     @param init valore dell'attributo per gli archi esistenti e nuovi.
+     
+     @return indice della colonna.
+     */
+    int addColumn(long long init = 0) {
+        columns.push_back(std::vector<long long>(src.size(), init));
+        initial.push_back(init);
+        return columns.size() - 1;
+    }
+    
+    /**
+     Metodo per aggiungere un nodo.
+     
+     @brief Metodo per l'inserimento di nuovi nodi nel grafo.
+     
+     @param node nodo da aggiungere.
+     
+     @throw eccezione custom se il nodo esiste già
+     */
+    void addNode(const T &node) {
+        graph.addNode(node);
+        out_edges.push_back(std::vector<int>());
+        if (compacted)
+            offset.push_back(offset.back());
+    }
+    
+    /**
+     Metodo per rimuovere un nodo con tutti i suoi archi (entranti e uscenti).
+     
+     @brief Metodo per la rimozione di nodi dal grafo.
+     
+     @param node nodo da rimuovere.
+     
+     @throw eccezione custom se il nodo non esiste
+     */
+    void removeNode(const T &node) {
+        const int v = require(node, 998);
+        for (int e = src.size() - 1; e >= 0; --e) {
+            if (src[e] == v || dst[e] == v)
+                removeEdge(e);
+        }
+        graph.removeNode(node);
+        out_edges.erase(out_edges.begin() + v);
+        for (unsigned int e = 0; e < src.size(); ++e) {
+            if (src[e] > v)
+                --src[e];
+            if (dst[e] > v)
+                --dst[e];
+        }
+        if (compacted)
+            offset.erase(offset.begin() + v + 1);
+    }
+    
+    /**
+     Metodo per aggiungere un arco; sono ammessi archi paralleli. Gli
+     attributi del nuovo arco valgono il valore iniziale delle colonne.
+     
+     @brief Metodo per l'inserimento di nuovi archi nel grafo.
+     
+     @param node1 nodo di partenza dell'arco.
+     @param node2 nodo di destinazione dell'arco.
+     
+     @throw eccezione custom se uno dei nodi non esiste
+     
+     @return indice del nuovo arco.
+     */
+    int addEdge(const T &node1, const T &node2) {
+        const int a = require(node1, 997);
+        const int b = require(node2, 997);
+        const int e = src.size();
+        src.push_back(a);
+        dst.push_back(b);
+        for (unsigned int c = 0; c < columns.size(); ++c)
+            columns[c].push_back(initial[c]);
+        out_edges[a].push_back(e);
+        if (!graph.adjMatrix[a][b])
+            graph.addEdge(node1, node2);
+        compacted = false;
+        return e;
+    }
+    
+    /**
+     Metodo per rimuovere un arco. L'ultimo arco (se diverso) prende
+     l'indice dell'arco rimosso.
+     
+     @brief Metodo per la rimozione di archi dal grafo.
+     
+     @param edge indice dell'arco.
+     
+     @throw eccezione custom se l'indice non è valido
+     */
+    void removeEdge(int edge) {
+        check_edge(edge);
+        const int a = src[edge];
+        const int b = dst[edge];
+        const int last = src.size() - 1;
+        relabel(a, edge, -1);
+        if (edge != last) {
+            relabel(src[last], last, edge);
+            src[edge] = src[last];
+            dst[edge] = dst[last];
+            for (unsigned int c = 0; c < columns.size(); ++c)
+                columns[c][edge] = columns[c][last];
+        }
+        src.pop_back();
+        dst.pop_back();
+        for (unsigned int c = 0; c < columns.size(); ++c)
+            columns[c].pop_back();
+        if (multiplicity_at(a, b) == 0)
+            graph.removeEdge(graph.array[a], graph.array[b]);
+        compacted = false;
+    }
+    
+    /**
+     Metodo per conoscere il numero di archi paralleli tra due nodi.
+     
+     @brief Metodo per conoscere la molteplicità di un arco.
+     
+     @param node1 nodo di partenza.
+     @param node2 nodo di destinazione.
+     
+     @throw eccezione custom se uno o entrambi i nodi non esistono
+     
+     @return numero di archi da node1 a node2.
+     */
+    int multiplicity(const T &node1, const T &node2) const {
+        return multiplicity_at(require(node1, 993), require(node2, 993));
+    }
+    
+    /**
+     Metodo per sapere se esiste almeno un arco tra due nodi.
+     
+     @brief Metodo per sapere se esiste un certo arco tra due nodi.
+     
+     @param node1 nodo di partenza.
+     @param node2 nodo di destinazione.
+     
+     @throw eccezione custom se uno o entrambi i nodi non esistono
+     
+     @return true se esiste, false altrimenti.
+     */
+    bool hasEdge(const T &node1, const T &node2) const {
+        return graph.adjMatrix[require(node1, 993)][require(node2, 993)];
+    }
+    
+    /**
+     Metodo per accedere a un attributo di un arco.
+     
+     @brief Metodo per accedere a un attributo di un arco.
+     
+     @param edge indice dell'arco.
+     @param col indice della colonna.
+     
+     @throw eccezione custom se gli indici non sono validi
+     
+     @return riferimento al valore dell'attributo.
+     */
+    long long &attribute(int edge, int col) {
+        check_edge(edge);
+        check_column(col);
+        return columns[col][edge];
+    }
+    
+    const long long &attribute(int edge, int col) const {
+        check_edge(edge);
+        check_column(col);
+        return columns[col][edge];
+    }
+    
+    /**
+     Metodo per riordinare gli archi per nodo di partenza (ordinamento
+     stabile), rendendo contigui gli archi uscenti da ogni nodo.
+     
+     @brief Metodo per compattare gli archi per nodo di partenza.
+     
+     @return per ogni vecchio indice di arco, il nuovo indice.
+     */
+    std::vector<int> compact() {
+        const int n = graph.num_nodes();
+        const int m = src.size();
+        offset.assign(n + 1, 0);
+        for (int e = 0; e < m; ++e)
+            ++offset[src[e] + 1];
+        for (int i = 0; i < n; ++i)
+            offset[i + 1] += offset[i];
+        std::vector<int> moved(m);
+        std::vector<int> fill(offset.begin(), offset.end() - 1);
+        for (int e = 0; e < m; ++e)
+            moved[e] = fill[src[e]]++;
+        std::vector<int> _src(m), _dst(m);
+        for (int e = 0; e < m; ++e) {
+            _src[moved[e]] = src[e];
+            _dst[moved[e]] = dst[e];
+        }
+        src.swap(_src);
+        dst.swap(_dst);
+        for (unsigned int c = 0; c < columns.size(); ++c) {
+            std::vector<long long> col(m);
+            for (int e = 0; e < m; ++e)
+                col[moved[e]] = columns[c][e];
+            columns[c].swap(col);
+        }
+        for (int i = 0; i < n; ++i) {
+            out_edges[i].clear();
+            for (int e = offset[i]; e < offset[i + 1]; ++e)
+                out_edges[i].push_back(e);
+        }
+        compacted = true;
+        return moved;
+    }
+    
+    /**
+     Metodo per sommare un attributo sugli archi uscenti da un nodo. Dopo
+     compact() la somma scorre una porzione contigua della colonna.
+     
+     @brief Metodo per sommare un attributo sugli archi uscenti.
+     
+     @param node nodo di partenza.
+     @param col indice della colonna.
+     
+     @throw eccezione custom se il nodo non esiste o la colonna non è valida
+     
+     @return somma dell'attributo, 0 se il nodo non ha archi uscenti.
+     */
+    long long sumOut(const T &node, int col) const {
+        const int v = require(node, 990);
+        check_column(col);
+        const long long *values = columns[col].empty() ? nullptr : &columns[col][0];
+        long long sum = 0;
+        if (compacted) {
+            for (int e = offset[v]; e < offset[v + 1]; ++e)
+                sum += values[e];
+        } else {
+            const std::vector<int> &list = out_edges[v];
+            for (unsigned int k = 0; k < list.size(); ++k)
+                sum += values[list[k]];
+        }
+        return sum;
+    }
+    
+    /**
+     Metodo per il massimo di un attributo sugli archi uscenti da un nodo.
+     Dopo compact() il massimo scorre una porzione contigua della colonna.
+     
+     @brief Metodo per il massimo di un attributo sugli archi uscenti.
+     
+     @param node nodo di partenza.
+     @param col indice della colonna.
+     
+     @throw eccezione custom se il nodo non esiste o la colonna non è valida
+     
+     @return massimo dell'attributo, il minimo long long se il nodo non ha archi uscenti.
+     */
+    long long maxOut(const T &node, int col) const {
+        const int v = require(node, 990);
+        check_column(col);
+        const long long *values = columns[col].empty() ? nullptr : &columns[col][0];
+        long long best = std::numeric_limits<long long>::min();
+        if (compacted) {
+            for (int e = offset[v]; e < offset[v + 1]; ++e)
+                best = std::max(best, values[e]);
+        } else {
+            const std::vector<int> &list = out_edges[v];
+            for (unsigned int k = 0; k < list.size(); ++k)
+                best = std::max(best, values[list[k]]);
+        }
+        return best;
+    }
+    
+    /**
+     Metodo per conoscere il nodo di partenza di un arco.
+     
+     @brief Metodo per conoscere il nodo di partenza di un arco.
+     
+     @param edge indice dell'arco.
+     
+     @throw eccezione custom se l'indice non è valido
+     
+     @return nodo di partenza.
+     */
+    const T &source(int edge) const {
+        check_edge(edge);
+        return graph.array[src[edge]];
+    }
+    
+    /**
+     Metodo per conoscere il nodo di arrivo di un arco.
+     
+     @brief Metodo per conoscere il nodo di arrivo di un arco.
+     
+     @param edge indice dell'arco.
+     
+     @throw eccezione custom se l'indice non è valido
+     
+     @return nodo di arrivo.
+     */
+    const T &target(int edge) const {
+        check_edge(edge);
+        return graph.array[dst[edge]];
+    }
+    
+    /**
+     Metodo per accedere alla struttura del grafo (adiacenza senza
+     molteplicità), su cui eseguire gli algoritmi di Graph.
+     
+     @brief Metodo per accedere al grafo senza molteplicità.
+     
+     @return riferimento costante al grafo.
+     */
+    const Graph<T,E> &structure() const {
+        return graph;
+    }
+    
+    // Numero di nodi del grafo
+    int num_nodes() const {
+        return graph.num_nodes();
+    }
+    
+    // Numero di archi, contando quelli paralleli
+    int num_edges() const {
+        return src.size();
+    }
+};
+
+#endif /* MultiGraph_h */
@@ -0,0 +1,477 @@
+//
+//  PartitionedGraph.hpp
+//
+//
+//  Grafo diretto su disco, con la matrice di adiacenza divisa in blocchi
+//  (tile) e una cache LRU in memoria.
+//
+
+#ifndef PartitionedGraph_h
+#define PartitionedGraph_h
+
+#include <vector>
+#include <list>
+#include <string>
+#include <algorithm>  // std::sort
+#include <cstring>    // std::memset, std::memcpy
+#include <memory>     // std::unique_ptr
+#include <cerrno>
+#include <climits>    // INT_MAX
+#include "Graph.hpp"
+
+// Il grafo su disco usa le chiamate POSIX (pread, pwrite): disponibile
+// solo dove è definita la macro GRAPH_PARTITIONED
+#if defined(__unix__) || defined(__APPLE__)
+#define GRAPH_PARTITIONED
+#include <fcntl.h>    // open
+#include <unistd.h>   // pread, pwrite, ftruncate, close
+
+/**
+    Classe che implementa un grafo diretto sui nodi 0..n-1 la cui matrice di
+    adiacenza, compattata a bit, è divisa in tile quadrati di lato fisso
+    memorizzati in un file. I tile della stessa riga di tile sono contigui nel
+    file, quindi la scansione dei vicini di un nodo legge il file in modo
+    sequenziale. In memoria restano al più i tile consentiti dal budget,
+    gestiti con politica LRU; i tile modificati sono riscritti su disco
+    quando vengono espulsi o con flush.
+ 
+    Il file è sparso: i tile mai scritti non occupano spazio su disco.
+ 
+    @brief Grafo diretto su disco a tile con cache LRU
+ */
+class PartitionedGraph {
+    
+    enum {
+        HEADER_BYTES = 4096,       // Dimensione dell'intestazione del file
+        MAGIC = 0x54504752         // "GRPT"
+    };
+    
+    // Intestazione del file
+    struct header {
+        long long magic;
+        long long n_node;
+        long long side;
+        long long n_edge;
+    };
+    
+    // Tile in memoria
+    struct tile {
+        long long id;                         // Indice del tile nel file
+        std::vector<unsigned long long> bits; // Bit della porzione di matrice
+        bool dirty;                           // true se modificato rispetto al file
+    };
+    
+    int fd;                        // File dei tile
+    int n_node;                    // Numero di nodi
+    int side;                      // Lato di un tile (multiplo di 64)
+    int tiles_per_side;            // Tile per riga della matrice
+    long long n_edge;              // Numero di archi
+    size_t tile_words;             // Parole da 64 bit per tile
+    size_t max_tiles;              // Tile massimi in memoria
+    std::list<tile> cache;         // Tile in memoria, dal più recente
+    std::vector<std::list<tile>::iterator> where; // Posizione in cache di ogni tile
+    unsigned long long n_reads;    // Tile letti da disco
+    unsigned long long n_writes;   // Tile scritti su disco
+    
+    PartitionedGraph(const PartitionedGraph &other);            // non copiabile
+    PartitionedGraph &operator=(const PartitionedGraph &other); // non assegnabile
+    PartitionedGraph(const std::string &path, size_t memory_budget); // usare open()
+    
+    // Offset nel file del tile id
+    off_t offset_of(long long id) const {
+        return (off_t)HEADER_BYTES + (off_t)id * tile_words * sizeof(unsigned long long);
+    }
+    
+    // Legge o scrive esattamente len byte all'offset indicato
+    void io(bool write, void *buf, size_t len, off_t off) const {
+        char *p = static_cast<char*>(buf);
+        while (len > 0) {
+            ssize_t r = write ? ::pwrite(fd, p, len, off) : ::pread(fd, p, len, off);
+            if (r < 0 && errno == EINTR)
+                continue;
+            if (r < 0) {
+                throw customException("Valore non valido!", 982);
+            }
+            if (r == 0) {
+                if (write) {
+                    throw customException("Valore non valido!", 982);
+                }
+                std::memset(p, 0, len);  // oltre la fine del file: tile vuoto
+                return;
+            }
+            p += r;
+            len -= r;
+            off += r;
+        }
+    }
+    
+    // Scrive un tile su disco se modificato
+    void write_back(tile &t) {
+        if (t.dirty) {
+            io(true, &t.bits[0], tile_words * sizeof(unsigned long long), offset_of(t.id));
+            t.dirty = false;
+            ++n_writes;
+        }
+    }
+    
+    // Scrive l'intestazione del file
+    void write_header() {
+        char buf[HEADER_BYTES];
+        std::memset(buf, 0, sizeof(buf));
+        header h;
+        h.magic = MAGIC;
+        h.n_node = n_node;
+        h.side = side;
+        h.n_edge = n_edge;
+        std::memcpy(buf, &h, sizeof(h));
+        io(true, buf, sizeof(buf), 0);
+    }
+    
+    // Inizializza le strutture derivate da n_node e side
+    void setup(size_t memory_budget) {
+        tiles_per_side = (n_node + side - 1) / side;
+        tile_words = (size_t)side * side / 64;
+        max_tiles = memory_budget / (tile_words * sizeof(unsigned long long));
+        if (max_tiles == 0)
+            max_tiles = 1;
+        where.assign((size_t)tiles_per_side * tiles_per_side, cache.end());
+    }
+    
+    /**
+        Metodo per ottenere un tile, leggendolo da disco se non è in cache ed
+        eventualmente espellendo il tile usato meno di recente.
+     
+        @brief Metodo per ottenere un tile dalla cache.
+     
+        @param ti riga del tile.
+        @param tj colonna del tile.
+     
+        @throw eccezione custom se la lettura o la scrittura falliscono
+     
+        @return riferimento al tile, valido fino al prossimo accesso a un altro tile.
+     */
+    tile &fetch(int ti, int tj) {
+        const long long id = (long long)ti * tiles_per_side + tj;
+        std::list<tile>::iterator it = where[id];
+        if (it != cache.end()) {
+            cache.splice(cache.begin(), cache, it);
+            return cache.front();
+        }
+        if (cache.size() >= max_tiles) {
+            tile &victim = cache.back();
+            write_back(victim);
+            where[victim.id] = cache.end();
+            // riuso il buffer del tile espulso
+            cache.splice(cache.begin(), cache, --cache.end());
+        } else {
+            cache.push_front(tile());
+            cache.front().bits.resize(tile_words);
+        }
+        tile &t = cache.front();
+        t.id = id;
+        t.dirty = false;
+        where[id] = cache.begin();
+        try {
+            io(false, &t.bits[0], tile_words * sizeof(unsigned long long), offset_of(id));
+        } catch (...) {
+            where[id] = cache.end();
+            cache.pop_front();
+            throw;
+        }
+        ++n_reads;
+        return t;
+    }
+    
+    // Verifica che un indice di nodo sia valido
+    void check(int node) const {
+        if (node < 0 || node >= n_node) {
+            throw customException("Valore non valido!", 983);
+        }
+    }
+    
+    // Riferimento alla parola e maschera del bit (i, j) in un tile
+    unsigned long long &word_of(tile &t, int i, int j, unsigned long long &mask) {
+        const int r = i % side;
+        const int c = j % side;
+        mask = 1ULL << (c & 63);
+        return t.bits[(size_t)r * (side / 64) + (c >> 6)];
+    }
+    
+    // Etichetta del costruttore di riapertura, usato solo da open()
+    struct reopen_tag {};
+    
+    // Costruttore che riapre un file dei tile scritto in precedenza
+    PartitionedGraph(const std::string &path, size_t memory_budget, reopen_tag)
+        : fd(-1), n_node(0), side(64), n_edge(0), n_reads(0), n_writes(0) {
+        fd = ::open(path.c_str(), O_RDWR);
+        if (fd < 0) {
+            throw customException("Valore non valido!", 982);
+        }
+        try {
+            header h;
+            io(false, &h, sizeof(h), 0);
+            if (h.magic != MAGIC || h.n_node < 0 || h.n_node > INT_MAX ||
+                h.side <= 0 || h.side > INT_MAX || h.side % 64 != 0 ||
+                h.n_edge < 0 || h.n_edge > h.n_node * h.n_node) {
+                throw customException("Valore non valido!", 982);
+            }
+            n_node = h.n_node;
+            side = h.side;
+            n_edge = h.n_edge;
+            setup(memory_budget);
+        } catch (...) {
+            ::close(fd);
+            throw;
+        }
+    }
+    
+public:
+    /**
+        @brief Costruttore di un nuovo grafo su disco
+     
+        Costruttore che crea (o sovrascrive) il file dei tile per un grafo di
+        n nodi senza archi.
+     
+        @param path percorso del file dei tile
+        @param n numero di nodi
+        @param tile_side lato di un tile, multiplo di 64
+        @param memory_budget memoria massima (in byte) per la cache dei tile
+     
+        @throw eccezione custom se i parametri non sono validi
+        @throw eccezione custom se il file non può essere creato
+     */
+    PartitionedGraph(const std::string &path, int n, int tile_side = 4096, size_t memory_budget = 256u << 20)
+        : fd(-1), n_node(n), side(tile_side), n_edge(0), n_reads(0), n_writes(0) {
+        if (n < 0 || tile_side <= 0 || tile_side % 64 != 0) {
+            throw customException("Valore non valido!", 983);
+        }
+        fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            throw customException("Valore non valido!", 982);
+        }
+        try {
+            setup(memory_budget);
+            write_header();
+        } catch (...) {
+            ::close(fd);
+            throw;
+        }
+    }
+    
+    /**
+     Metodo per riaprire un file dei tile scritto in precedenza. È un metodo
+     con nome, e non un costruttore, per non confondersi con il costruttore
+     di un nuovo grafo (che sovrascrive il file).
+     
+     @brief Metodo per riaprire un grafo su disco.
+     
+     @param path percorso del file dei tile
+     @param memory_budget memoria massima (in byte) per la cache dei tile
+     
+     @throw eccezione custom se il file non può essere aperto o non è valido
+     
+     @return grafo riaperto (non copiabile, quindi posseduto dal puntatore).
+     */
+    static std::unique_ptr<PartitionedGraph> open(const std::string &path, size_t memory_budget = 256u << 20) {
+        return std::unique_ptr<PartitionedGraph>(new PartitionedGraph(path, memory_budget, reopen_tag()));
+    }
+    
+    /**
+        @brief Distruttore della classe
+     
+        Distruttore che scrive su disco i tile modificati e chiude il file.
+     */
+    ~PartitionedGraph() {
+        try {
+            flush();
+        } catch (...) {
+        }
+        ::close(fd);
+    }
+    
+    /**
+     Metodo per scrivere su disco i tile modificati e l'intestazione.
+     
+     @brief Metodo per salvare su disco le modifiche.
+     
+     @throw eccezione custom se la scrittura fallisce
+     */
+    void flush() {
+        for (std::list<tile>::iterator it = cache.begin(); it != cache.end(); ++it)
+            write_back(*it);
+        write_header();
+    }
+    
+    /**
+     Metodo per l'inserimento di un nuovo arco.
+     
+     @brief Metodo per l'inserimento di nuovi archi nel grafo.
+     
+     @param node1 nodo di partenza dell'arco.
+     @param node2 nodo di destinazione dell'arco.
+     
+     @throw eccezione custom se un nodo non è valido o l'arco esiste già
+     @throw eccezione custom se l'accesso al file fallisce
+     */
+    void addEdge(int node1, int node2) {
+        check(node1);
+        check(node2);
+        tile &t = fetch(node1 / side, node2 / side);
+        unsigned long long mask;
+        unsigned long long &w = word_of(t, node1, node2, mask);
+        if (w & mask) {
+            throw customException("Valore non valido!", 996);
+        }
+        w |= mask;
+        t.dirty = true;
+        ++n_edge;
+    }
+    
+    /**
+     Metodo per la rimozione di un arco.
+     
+     @brief Metodo per la rimozione di archi dal grafo.
+     
+     @param node1 nodo di partenza dell'arco.
+     @param node2 nodo di destinazione dell'arco.
+     
+     @throw eccezione custom se un nodo non è valido o l'arco non esiste
+     @throw eccezione custom se l'accesso al file fallisce
+     */
+    void removeEdge(int node1, int node2) {
+        check(node1);
+        check(node2);
+        tile &t = fetch(node1 / side, node2 / side);
+        unsigned long long mask;
+        unsigned long long &w = word_of(t, node1, node2, mask);
+        if (!(w & mask)) {
+            throw customException("Valore non valido!", 994);
+        }
+        w &= ~mask;
+        t.dirty = true;
+        --n_edge;
+    }
+    
+    /**
+     Metodo per sapere se una coppia di nodi è connessa da un arco.
+     
+     @brief Metodo per sapere se esiste un certo arco tra due nodi.
+     
+     @param node1 nodo di partenza.
+     @param node2 nodo di destinazione.
+     
+     @throw eccezione custom se un nodo non è valido
+     @throw eccezione custom se l'accesso al file fallisce
+     
+     @return true se esiste, false altrimenti.
+     */
+    bool hasEdge(int node1, int node2) {
+        check(node1);
+        check(node2);
+        tile &t = fetch(node1 / side, node2 / side);
+        unsigned long long mask;
+        return (word_of(t, node1, node2, mask) & mask) != 0;
+    }
+    
+    /**
+     Metodo per conoscere i successori di un nodo, leggendo in ordine i tile
+     della sua riga.
+     
+     @brief Metodo per conoscere i successori di un nodo.
+     
+     @param node nodo di partenza.
+     
+     @throw eccezione custom se il nodo non è valido
+     @throw eccezione custom se l'accesso al file fallisce
+     
+     @return successori in ordine crescente.
+     */
+    std::vector<int> successors(int node) {
+        check(node);
+        std::vector<int> result;
+        const int ti = node / side;
+        const size_t row = (size_t)(node % side) * (side / 64);
+        for (int tj = 0; tj < tiles_per_side; ++tj) {
+            const tile &t = fetch(ti, tj);
+            for (int w = 0; w < side / 64; ++w) {
+                for (unsigned long long x = t.bits[row + w]; x != 0; x &= x - 1)
+                    result.push_back(tj * side + w * 64 + graph_bits::lowest_bit(x));
+            }
+        }
+        return result;
+    }
+    
+    /**
+     Metodo per la visita in ampiezza da un nodo. Ad ogni livello la
+     frontiera è ordinata e raggruppata per riga di tile, così ogni tile
+     viene letto al più una volta per livello, in ordine di file.
+     
+     @brief Metodo per la visita in ampiezza da un nodo.
+     
+     @param source nodo di partenza.
+     
+     @throw eccezione custom se il nodo non è valido
+     @throw eccezione custom se l'accesso al file fallisce
+     
+     @return distanza (numero di archi) di ogni nodo da source, -1 se non raggiungibile.
+     */
+    std::vector<int> bfs(int source) {
+        check(source);
+        std::vector<int> dist(n_node, -1);
+        std::vector<int> frontier(1, source), next;
+        dist[source] = 0;
+        for (int level = 1; !frontier.empty(); ++level) {
+            std::sort(frontier.begin(), frontier.end());
+            next.clear();
+            unsigned int lo = 0;
+            while (lo < frontier.size()) {
+                const int ti = frontier[lo] / side;
+                unsigned int hi = lo;
+                while (hi < frontier.size() && frontier[hi] / side == ti)
+                    ++hi;
+                for (int tj = 0; tj < tiles_per_side; ++tj) {
+                    const tile &t = fetch(ti, tj);
+                    for (unsigned int f = lo; f < hi; ++f) {
+                        const size_t row = (size_t)(frontier[f] % side) * (side / 64);
+                        for (int w = 0; w < side / 64; ++w) {
+                            for (unsigned long long x = t.bits[row + w]; x != 0; x &= x - 1) {
+                                const int v = tj * side + w * 64 + graph_bits::lowest_bit(x);
+                                if (dist[v] < 0) {
+                                    dist[v] = level;
+                                    next.push_back(v);
+                                }
+                            }
+                        }
+                    }
+                }
+                lo = hi;
+            }
+            frontier.swap(next);
+        }
+        return dist;
+    }
+    
+    // Numero di nodi del grafo
+    int num_nodes() const {
+        return n_node;
+    }
+    
+    // Numero di archi del grafo
+    long long num_edges() const {
+        return n_edge;
+    }
+    
+    // Numero di tile letti da disco
+    unsigned long long tile_reads() const {
+        return n_reads;
+    }
+    
+    // Numero di tile scritti su disco
+    unsigned long long tile_writes() const {
+        return n_writes;
+    }
+};
+
+#endif /* GRAPH_PARTITIONED */
+
+#endif /* PartitionedGraph_h */
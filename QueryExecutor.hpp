@@ -0,0 +1,315 @@
+//
+//  QueryExecutor.hpp
+//
+//
+//  Esecutore asincrono di interrogazioni su un Graph.
+//
+
+#ifndef QueryExecutor_h
+#define QueryExecutor_h
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <exception>
+#include <algorithm> // std::sort
+#include "Graph.hpp"
+
+/**
+    Classe che esegue in modo asincrono interrogazioni (esistenza di un arco,
+    raggiungibilità) su un grafo, con un pool di thread e una coda limitata.
+    Ogni thread preleva dalla coda un lotto di interrogazioni: i nodi del
+    lotto sono risolti con una sola scansione dell'array dei nodi, le
+    interrogazioni sono ordinate per nodo di partenza in modo che le righe
+    della matrice di adiacenza vengano lette una volta sola, e le
+    raggiungibilità con la stessa partenza condividono la stessa visita.
+ 
+    Il grafo non deve essere modificato mentre l'esecutore è attivo.
+ 
+    @brief Esecutore asincrono di interrogazioni su un grafo
+ 
+    @param T tipo del dato
+    @param E funtore di comparazione (uguaglianza) tra due dati
+ */
+template <typename T, typename E>
+class GraphQueryExecutor {
+    
+    enum query_kind { QUERY_HAS_EDGE, QUERY_REACHABLE };
+    
+    // Interrogazione in coda
+    struct query {
+        query_kind kind;
+        T from;
+        T to;
+        std::promise<bool> result;
+        int src;  // indice del nodo di partenza, -1 se non esiste
+        int dst;  // indice del nodo di arrivo, -1 se non esiste
+        
+        query(query_kind k, const T &a, const T &b) : kind(k), from(a), to(b), src(-1), dst(-1) {}
+    };
+    
+    // Ordina le interrogazioni per tipo e nodo di partenza
+    struct query_less {
+        bool operator()(const query *a, const query *b) const {
+            if (a->kind != b->kind)
+                return a->kind < b->kind;
+            return a->src < b->src;
+        }
+    };
+    
+    const Graph<T,E> &graph;              // Grafo interrogato (non posseduto)
+    std::deque<query> queue;              // Interrogazioni in attesa
+    unsigned int capacity;                // Dimensione massima della coda
+    unsigned int batch;                   // Dimensione massima di un lotto
+    bool stopping;                        // true dopo shutdown
+    std::mutex mtx;
+    std::condition_variable not_empty;
+    std::condition_variable not_full;
+    std::vector<std::thread> workers;
+    
+    GraphQueryExecutor(const GraphQueryExecutor &other);            // non copiabile
+    GraphQueryExecutor &operator=(const GraphQueryExecutor &other); // non assegnabile
+    
+    /**
+        Metodo per accodare un'interrogazione, attendendo se la coda è piena.
+     
+        @brief Metodo per accodare un'interrogazione.
+     
+        @throw eccezione custom se l'esecutore è stato fermato
+     
+        @return future del risultato.
+     */
+    std::future<bool> submit(query_kind kind, const T &a, const T &b) {
+        std::unique_lock<std::mutex> lock(mtx);
+        while (!stopping && queue.size() >= capacity)
+            not_full.wait(lock);
+        if (stopping) {
+            throw customException("Valore non valido!", 986);
+        }
+        queue.push_back(query(kind, a, b));
+        std::future<bool> f = queue.back().result.get_future();
+        lock.unlock();
+        not_empty.notify_one();
+        return f;
+    }
+    
+    /**
+        Metodo per risolvere gli indici dei nodi di un lotto con una sola
+        scansione dell'array dei nodi del grafo.
+     
+        @brief Metodo per risolvere i nodi di un lotto.
+     */
+    void resolve(std::vector<query> &work) const {
+        // Chiavi distinte del lotto
+        std::vector<const T*> keys;
+        std::vector<int*> slots;
+        std::vector<int> key_of;
+        for (unsigned int q = 0; q < work.size(); ++q) {
+            const T *ends[2] = { &work[q].from, &work[q].to };
+            int *out[2] = { &work[q].src, &work[q].dst };
+            for (int e = 0; e < 2; ++e) {
+                unsigned int k = 0;
+                while (k < keys.size() && !graph._eql(*keys[k], *ends[e]))
+                    ++k;
+                if (k == keys.size())
+                    keys.push_back(ends[e]);
+                key_of.push_back(k);
+                slots.push_back(out[e]);
+            }
+        }
+        std::vector<int> index(keys.size(), -1);
+        unsigned int missing = keys.size();
+        for (int i = 0; i < graph.n_node && missing > 0; ++i) {
+            for (unsigned int k = 0; k < keys.size(); ++k) {
+                if (index[k] < 0 && graph._eql(graph.array[i], *keys[k])) {
+                    index[k] = i;
+                    --missing;
+                    break;
+                }
+            }
+        }
+        for (unsigned int s = 0; s < slots.size(); ++s)
+            *slots[s] = index[key_of[s]];
+    }
+    
+    // Visita in ampiezza da src, marca in reached i nodi raggiungibili
+    void visit(int src, std::vector<char> &reached, std::vector<int> &frontier) const {
+        const int n = graph.n_node;
+        reached.assign(n, 0);
+        frontier.clear();
+        reached[src] = 1;
+        frontier.push_back(src);
+        for (unsigned int head = 0; head < frontier.size(); ++head) {
+            const bool *row = graph.adjMatrix[frontier[head]];
+            for (int j = 0; j < n; ++j) {
+                if (row[j] && !reached[j]) {
+                    reached[j] = 1;
+                    frontier.push_back(j);
+                }
+            }
+        }
+    }
+    
+    // Esegue un lotto di interrogazioni e completa i future
+    void run(std::vector<query> &work) const {
+        resolve(work);
+        std::vector<query*> order;
+        for (unsigned int q = 0; q < work.size(); ++q) {
+            if (work[q].src < 0 || work[q].dst < 0) {
+                work[q].result.set_exception(std::make_exception_ptr(customException("Valore non valido!", 993)));
+            } else {
+                order.push_back(&work[q]);
+            }
+        }
+        std::sort(order.begin(), order.end(), query_less());
+        std::vector<char> reached;
+        std::vector<int> frontier;
+        int visited_from = -1;
+        for (unsigned int q = 0; q < order.size(); ++q) {
+            query &cur = *order[q];
+            if (cur.kind == QUERY_HAS_EDGE) {
+                cur.result.set_value(graph.adjMatrix[cur.src][cur.dst]);
+            } else {
+                if (visited_from != cur.src) {
+                    visit(cur.src, reached, frontier);
+                    visited_from = cur.src;
+                }
+                cur.result.set_value(reached[cur.dst] != 0);
+            }
+        }
+    }
+    
+    // Ciclo dei thread: preleva lotti finché la coda non è vuota e ferma
+    void worker() {
+        std::vector<query> work;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                while (!stopping && queue.empty())
+                    not_empty.wait(lock);
+                if (queue.empty())
+                    return;
+                while (!queue.empty() && work.size() < batch) {
+                    work.push_back(std::move(queue.front()));
+                    queue.pop_front();
+                }
+            }
+            not_full.notify_all();
+            try {
+                run(work);
+            } catch (...) {
+                // il lotto non è stato completato: l'eccezione va alle interrogazioni ancora senza risultato
+                std::exception_ptr failure = std::current_exception();
+                for (unsigned int q = 0; q < work.size(); ++q) {
+                    try {
+                        work[q].result.set_exception(failure);
+                    } catch (const std::future_error &) {
+                        // risultato già impostato
+                    }
+                }
+            }
+            work.clear();
+        }
+    }
+    
+public:
+    /**
+        @brief Costruttore dell'esecutore
+     
+        Costruttore che avvia il pool di thread sul grafo indicato.
+     
+        @param g grafo da interrogare, non deve essere modificato finché l'esecutore è attivo
+        @param threads numero di thread (0 = numero di core disponibili)
+        @param queue_capacity numero massimo di interrogazioni in attesa
+        @param batch_size numero massimo di interrogazioni eseguite in un lotto
+     
+        @throw eccezione custom se capacità o dimensione del lotto sono nulle
+        @throw std::system_error se un thread non può essere avviato
+     */
+    explicit GraphQueryExecutor(const Graph<T,E> &g, unsigned int threads = 0,
+                                unsigned int queue_capacity = 1024, unsigned int batch_size = 64)
+        : graph(g), capacity(queue_capacity), batch(batch_size), stopping(false) {
+        if (queue_capacity == 0 || batch_size == 0) {
+            throw customException("Valore non valido!", 986);
+        }
+        if (threads == 0)
+            threads = std::thread::hardware_concurrency();
+        if (threads == 0)
+            threads = 1;
+        try {
+            workers.reserve(threads);  // push_back non rialloca con thread già avviati
+            for (unsigned int t = 0; t < threads; ++t)
+                workers.push_back(std::thread(&GraphQueryExecutor::worker, this));
+        } catch (...) {
+            // i thread già avviati vanno fermati prima di propagare l'errore
+            shutdown();
+            throw;
+        }
+    }
+    
+    /**
+        @brief Distruttore della classe
+     
+        Distruttore che completa le interrogazioni in coda e ferma i thread.
+     */
+    ~GraphQueryExecutor() {
+        shutdown();
+    }
+    
+    /**
+     Metodo per accodare la verifica dell'esistenza di un arco.
+     
+     @brief Metodo asincrono per sapere se esiste un certo arco tra due nodi.
+     
+     @param node1 nodo di partenza.
+     @param node2 nodo di destinazione.
+     
+     @throw eccezione custom se l'esecutore è stato fermato
+     
+     @return future del risultato; contiene un'eccezione custom se uno dei nodi non esiste.
+     */
+    std::future<bool> hasEdge(const T &node1, const T &node2) {
+        return submit(QUERY_HAS_EDGE, node1, node2);
+    }
+    
+    /**
+     Metodo per accodare la verifica dell'esistenza di un cammino tra due nodi.
+     Un nodo è sempre raggiungibile da se stesso.
+     
+     @brief Metodo asincrono per sapere se node2 è raggiungibile da node1.
+     
+     @param node1 nodo di partenza.
+     @param node2 nodo di destinazione.
+     
+     @throw eccezione custom se l'esecutore è stato fermato
+     
+     @return future del risultato; contiene un'eccezione custom se uno dei nodi non esiste.
+     */
+    std::future<bool> reachable(const T &node1, const T &node2) {
+        return submit(QUERY_REACHABLE, node1, node2);
+    }
+    
+    /**
+     Metodo per fermare l'esecutore: le interrogazioni già in coda vengono
+     completate, quelle successive vengono rifiutate.
+     
+     @brief Metodo per fermare l'esecutore.
+     */
+    void shutdown() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopping = true;
+        }
+        not_empty.notify_all();
+        not_full.notify_all();
+        for (unsigned int t = 0; t < workers.size(); ++t) {
+            if (workers[t].joinable())
+                workers[t].join();
+        }
+    }
+};
+
+#endif /* QueryExecutor_h */
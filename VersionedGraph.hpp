@@ -0,0 +1,361 @@
+//
+//  VersionedGraph.hpp
+//
+//
+//  Grafo con storico delle modifiche e interrogazioni per versione.
+//
+
+#ifndef VersionedGraph_h
+#define VersionedGraph_h
+
+#include <vector>
+#include <utility>   // std::pair
+#include <algorithm> // std::lower_bound, std::binary_search
+#include "Graph.hpp"
+
+/**
+    Classe che implementa un grafo diretto versionato. Ogni modifica riuscita
+    (addNode, removeNode, addEdge, removeEdge) incrementa il numero di
+    versione ed è registrata in un log append-only; ogni interval modifiche
+    viene salvato un checkpoint compatto (nodi e lista ordinata degli archi,
+    non la matrice). Le interrogazioni su una versione partono dal checkpoint
+    precedente e rileggono al più interval voci del log.
+ 
+    La versione 0 è il grafo vuoto.
+ 
+    @brief Grafo diretto con interrogazioni per versione
+ 
+    @param T tipo del dato
+    @param E funtore di comparazione (uguaglianza) tra due dati
+ */
+template <typename T, typename E>
+class VersionedGraph {
+    
+    enum log_kind { LOG_ADD_NODE, LOG_REMOVE_NODE, LOG_ADD_EDGE, LOG_REMOVE_EDGE };
+    
+    // Voce del log: la voce k porta il grafo alla versione k + 1
+    struct log_entry {
+        log_kind kind;
+        T node1;
+        T node2;  // solo per gli archi
+        
+        log_entry(log_kind k, const T &a, const T &b) : kind(k), node1(a), node2(b) {}
+    };
+    
+    // Checkpoint compatto: nodi in ordine e archi come coppie di indici ordinate
+    struct checkpoint {
+        unsigned long version;
+        std::vector<T> nodes;
+        std::vector<std::pair<int,int> > edges;
+    };
+    
+    Graph<T,E> current;                  // Grafo all'ultima versione
+    std::vector<log_entry> log;          // Modifiche, una per versione
+    std::vector<checkpoint> checkpoints; // Checkpoint in ordine di versione
+    unsigned int interval;               // Modifiche tra due checkpoint
+    E _eql;                              // Istanza del funtore di uguaglianza
+    
+    /**
+        Metodo per preparare la voce del log di una modifica prima di
+        applicarla a current: la voce è già costruita e il log ha spazio per
+        accoglierla, quindi record non può fallire dopo la modifica.
+     
+        @brief Metodo per preparare una voce del log.
+     
+        @throw eccezione allocazione di memoria (current non è stato modificato)
+     */
+    log_entry prepare(log_kind kind, const T &a, const T &b) {
+        if (log.size() == log.capacity())
+            log.reserve(2 * log.size() + 16);
+        return log_entry(kind, a, b);
+    }
+    
+    // Registra una modifica preparata con prepare e, se necessario, un nuovo checkpoint
+    void record(log_entry &entry) {
+        log.push_back(std::move(entry));  // capacità già riservata
+        if (log.size() % interval == 0) {
+            try {
+                save_checkpoint();
+            } catch (const std::bad_alloc &) {
+                // la modifica è registrata: senza questo checkpoint le
+                // interrogazioni rileggono più voci del log
+            }
+        }
+    }
+    
+    // Salva un checkpoint della versione corrente
+    void save_checkpoint() {
+        checkpoint cp;
+        cp.version = log.size();
+        cp.nodes.assign(current.begin(), current.end());
+        const int n = current.n_node;
+        cp.edges.reserve(current.num_edges());
+        for (int i = 0; i < n; ++i) {
+            const bool *row = current.adjMatrix[i];
+            for (int j = 0; j < n; ++j) {
+                if (row[j])
+                    cp.edges.push_back(std::make_pair(i, j));
+            }
+        }
+        checkpoints.push_back(checkpoint());
+        checkpoints.back().version = cp.version;
+        checkpoints.back().nodes.swap(cp.nodes);
+        checkpoints.back().edges.swap(cp.edges);
+    }
+    
+    // Checkpoint più recente con versione <= version
+    const checkpoint &checkpoint_at(unsigned long version) const {
+        unsigned int lo = 0, hi = checkpoints.size();
+        while (hi - lo > 1) {
+            unsigned int mid = (lo + hi) / 2;
+            if (checkpoints[mid].version <= version)
+                lo = mid;
+            else
+                hi = mid;
+        }
+        return checkpoints[lo];
+    }
+    
+    // Indice di un nodo in un checkpoint, -1 se assente
+    int index_in(const checkpoint &cp, const T &node) const {
+        for (unsigned int i = 0; i < cp.nodes.size(); ++i) {
+            if (_eql(cp.nodes[i], node))
+                return i;
+        }
+        return -1;
+    }
+    
+    // Verifica che la versione esista
+    void check_version(unsigned long version) const {
+        if (version > log.size()) {
+            throw customException("Valore non valido!", 984);
+        }
+    }
+    
+public:
+    /**
+        @brief Costruttore di default
+     
+        Costruttore per istanziare un grafo versionato vuoto.
+     
+        @param checkpoint_interval numero di modifiche tra due checkpoint
+     
+        @throw eccezione custom se l'intervallo è nullo
+     */
+    explicit VersionedGraph(unsigned int checkpoint_interval = 1024) : interval(checkpoint_interval) {
+        if (checkpoint_interval == 0) {
+            throw customException("Valore non valido!", 984);
+        }
+        save_checkpoint();
+    }
+    
+    /**
+     Metodo per l'inserimento di un nuovo nodo (nuova versione).
+     
+     @brief Metodo per l'inserimento di nuovi nodi nel grafo.
+     
+     @param node nodo da aggiungere.
+     
+     @throw eccezione custom se il nodo esiste già
+     */
+    void addNode(const T &node) {
+        log_entry entry = prepare(LOG_ADD_NODE, node, node);
+        current.addNode(node);
+        record(entry);
+    }
+    
+    /**
+     Metodo per la rimozione di un nodo e dei suoi archi (nuova versione).
+     
+     @brief Metodo per la rimozione di nodi dal grafo.
+     
+     @param node nodo da rimuovere.
+     
+     @throw eccezione custom se il nodo non esiste
+     */
+    void removeNode(const T &node) {
+        log_entry entry = prepare(LOG_REMOVE_NODE, node, node);
+        current.removeNode(node);
+        record(entry);
+    }
+    
+    /**
+     Metodo per l'inserimento di un nuovo arco (nuova versione).
+     
+     @brief Metodo per l'inserimento di nuovi archi nel grafo.
+     
+     @param node1 nodo di partenza dell'arco.
+     @param node2 nodo di destinazione dell'arco.
+     
+     @throw eccezione custom se uno dei nodi non esiste o l'arco esiste già
+     */
+    void addEdge(const T &node1, const T &node2) {
+        log_entry entry = prepare(LOG_ADD_EDGE, node1, node2);
+        current.addEdge(node1, node2);
+        record(entry);
+    }
+    
+    /**
+     Metodo per la rimozione di un arco (nuova versione).
+     
+     @brief Metodo per la rimozione di archi dal grafo.
+     
+     @param node1 nodo di partenza dell'arco.
+     @param node2 nodo di destinazione dell'arco.
+     
+     @throw eccezione custom se uno dei nodi non esiste o l'arco non esiste
+     */
+    void removeEdge(const T &node1, const T &node2) {
+        log_entry entry = prepare(LOG_REMOVE_EDGE, node1, node2);
+        current.removeEdge(node1, node2);
+        record(entry);
+    }
+    
+    /**
+     Metodo per conoscere la versione corrente (numero di modifiche).
+     
+     @brief Metodo per conoscere la versione corrente.
+     
+     @return versione corrente.
+     */
+    unsigned long version() const {
+        return log.size();
+    }
+    
+    /**
+     Metodo per sapere se un nodo esisteva a una certa versione.
+     
+     @brief Metodo per sapere se esiste un certo nodo a una versione.
+     
+     @param node nodo da cercare.
+     @param version versione da interrogare.
+     
+     @throw eccezione custom se la versione non esiste
+     
+     @return true se il nodo esisteva, false altrimenti.
+     */
+    bool exists(const T &node, unsigned long version) const {
+        check_version(version);
+        const checkpoint &cp = checkpoint_at(version);
+        bool found = index_in(cp, node) >= 0;
+        for (unsigned long v = cp.version; v < version; ++v) {
+            const log_entry &e = log[v];
+            if ((e.kind == LOG_ADD_NODE || e.kind == LOG_REMOVE_NODE) && _eql(e.node1, node))
+                found = (e.kind == LOG_ADD_NODE);
+        }
+        return found;
+    }
+    
+    /**
+     Metodo per sapere se un arco esisteva a una certa versione.
+     
+     @brief Metodo per sapere se esiste un certo arco tra due nodi a una versione.
+     
+     @param node1 nodo di partenza.
+     @param node2 nodo di destinazione.
+     @param version versione da interrogare.
+     
+     @throw eccezione custom se la versione non esiste
+     @throw eccezione custom se uno dei nodi non esisteva a quella versione
+     
+     @return true se l'arco esisteva, false altrimenti.
+     */
+    bool hasEdge(const T &node1, const T &node2, unsigned long version) const {
+        check_version(version);
+        const checkpoint &cp = checkpoint_at(version);
+        const int a = index_in(cp, node1);
+        const int b = index_in(cp, node2);
+        bool has1 = a >= 0;
+        bool has2 = b >= 0;
+        bool edge = has1 && has2 &&
+                    std::binary_search(cp.edges.begin(), cp.edges.end(), std::make_pair(a, b));
+        for (unsigned long v = cp.version; v < version; ++v) {
+            const log_entry &e = log[v];
+            switch (e.kind) {
+                case LOG_ADD_NODE:
+                case LOG_REMOVE_NODE:
+                    if (_eql(e.node1, node1))
+                        has1 = (e.kind == LOG_ADD_NODE);
+                    if (_eql(e.node1, node2))
+                        has2 = (e.kind == LOG_ADD_NODE);
+                    if (e.kind == LOG_REMOVE_NODE && (_eql(e.node1, node1) || _eql(e.node1, node2)))
+                        edge = false;
+                    break;
+                case LOG_ADD_EDGE:
+                case LOG_REMOVE_EDGE:
+                    if (_eql(e.node1, node1) && _eql(e.node2, node2))
+                        edge = (e.kind == LOG_ADD_EDGE);
+                    break;
+            }
+        }
+        if (!has1 || !has2) {
+            throw customException("Valore non valido!", 993);
+        }
+        return edge;
+    }
+    
+    /**
+     Metodo per ricostruire il grafo a una certa versione: il checkpoint
+     precedente viene caricato con una sola riallocazione e le modifiche
+     successive sono rilette dal log.
+     
+     @brief Metodo per ricostruire il grafo a una versione.
+     
+     @param version versione da ricostruire.
+     
+     @throw eccezione custom se la versione non esiste
+     @throw eccezione allocazione di memoria
+     
+     @return grafo alla versione richiesta.
+     */
+    Graph<T,E> snapshot(unsigned long version) const {
+        check_version(version);
+        const checkpoint &cp = checkpoint_at(version);
+        typename Graph<T,E>::patch p;
+        p.added_nodes = cp.nodes;
+        p.added_edges = cp.edges;
+        Graph<T,E> g;
+        g.apply_patch(p, false);  // i nodi di un checkpoint sono distinti
+        for (unsigned long v = cp.version; v < version; ++v) {
+            const log_entry &e = log[v];
+            switch (e.kind) {
+                case LOG_ADD_NODE:
+                    g.addNode(e.node1);
+                    break;
+                case LOG_REMOVE_NODE:
+                    g.removeNode(e.node1);
+                    break;
+                case LOG_ADD_EDGE:
+                    g.addEdge(e.node1, e.node2);
+                    break;
+                case LOG_REMOVE_EDGE:
+                    g.removeEdge(e.node1, e.node2);
+                    break;
+            }
+        }
+        return g;
+    }
+    
+    /**
+     Metodo per accedere al grafo all'ultima versione.
+     
+     @brief Metodo per accedere al grafo corrente.
+     
+     @return riferimento costante al grafo corrente.
+     */
+    const Graph<T,E> &latest() const {
+        return current;
+    }
+    
+    // Numero di nodi all'ultima versione
+    int num_nodes() const {
+        return current.num_nodes();
+    }
+    
+    // Numero di archi all'ultima versione
+    int num_edges() const {
+        return current.num_edges();
+    }
+};
+
+#endif /* VersionedGraph_h */
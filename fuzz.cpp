@@ -0,0 +1,348 @@
+//
+//  fuzz.cpp
+//
+//
+//  Test differenziale casuale della classe Graph contro un modello di
+//  riferimento, con controllo del costo delle operazioni.
+//
+//  Uso: ./fuzz.exe [seme] [passi]   (oppure make fuzz FUZZ_ARGS="seme passi")
+//
+
+#include <iostream>
+#include "Graph.hpp"
+#include <cstdlib>
+#include <vector>
+#include <set>
+#include <utility>
+#include <algorithm>
+
+/**
+ Funtore per valutare l'uguaglianza tra interi.
+
+ @brief Funtore per valutare l'uguaglianza tra interi.
+ */
+struct equal_int {
+    bool operator()(int a, int b) const {
+        return a==b;
+    }
+};
+
+// Grafo su interi con statistiche: i limiti di costo sono verificati sui contatori
+typedef Graph<int, equal_int, collect_stats> graphtest;
+
+/**
+ Modello di riferimento: nodi in ordine di inserimento e insieme degli archi.
+ Ogni operazione ritorna il codice dell'eccezione che Graph deve lanciare
+ (0 se l'operazione va a buon fine).
+
+ @brief Modello di riferimento del grafo
+ */
+struct model {
+    std::vector<int> nodes;
+    std::set<std::pair<int,int> > edges;
+
+    bool exists(int v) const {
+        return std::find(nodes.begin(), nodes.end(), v) != nodes.end();
+    }
+
+    int addNode(int v) {
+        if (exists(v))
+            return 999;
+        nodes.push_back(v);
+        return 0;
+    }
+
+    int removeNode(int v) {
+        if (!exists(v))
+            return 998;
+        nodes.erase(std::find(nodes.begin(), nodes.end(), v));
+        std::set<std::pair<int,int> >::iterator it = edges.begin();
+        while (it != edges.end()) {
+            if (it->first == v || it->second == v)
+                edges.erase(it++);
+            else
+                ++it;
+        }
+        return 0;
+    }
+
+    int addEdge(int a, int b) {
+        if (!exists(a) || !exists(b))
+            return 997;
+        if (!edges.insert(std::make_pair(a, b)).second)
+            return 996;
+        return 0;
+    }
+
+    int removeEdge(int a, int b) {
+        if (!exists(a) || !exists(b))
+            return 995;
+        if (edges.erase(std::make_pair(a, b)) == 0)
+            return 994;
+        return 0;
+    }
+};
+
+// Generatore pseudocasuale xorshift64*, riproducibile su ogni piattaforma
+struct rng {
+    unsigned long long s;
+    explicit rng(unsigned long long seed) : s(seed * 2685821657736338717ULL + 1) {}
+    unsigned int next(unsigned int n) {
+        s ^= s >> 12;
+        s ^= s << 25;
+        s ^= s >> 27;
+        return (unsigned int)((s * 2685821657736338717ULL) >> 33) % n;
+    }
+};
+
+enum fuzz_op {
+    F_ADD_NODE, F_REMOVE_NODE, F_ADD_EDGE, F_REMOVE_EDGE, F_HAS_EDGE,
+    F_COPY, F_ASSIGN, F_SWAP, F_REVERSE, F_COUNT
+};
+
+static const char *op_names[F_COUNT] = {
+    "addNode", "removeNode", "addEdge", "removeEdge", "hasEdge",
+    "copy", "assign", "swap", "reverseIndex"
+};
+
+/**
+ Limiti di costo attesi per operazione, in funzione del numero n di nodi
+ prima dell'operazione: chiamate al funtore di uguaglianza e byte copiati.
+ Le costanti lasciano margine all'implementazione corrente; un'operazione
+ che passa a una classe di complessità superiore li supera.
+
+ @brief Limiti di costo delle operazioni
+ */
+static unsigned long long eql_bound(int op, unsigned long long n) {
+    switch (op) {
+        case F_ADD_NODE:    return n + 1;                 // O(n)
+        case F_REMOVE_NODE: return 24 * (n + 1) * (n + 1); // O(n^2)
+        case F_ADD_EDGE:
+        case F_REMOVE_EDGE:
+        case F_HAS_EDGE:    return 6 * (n + 1);           // O(n)
+        default:            return 0;                     // nessun confronto
+    }
+}
+
+static unsigned long long copy_bound(int op, unsigned long long n) {
+    const unsigned long long per_node = 64;
+    switch (op) {
+        case F_ADD_NODE:
+        case F_REMOVE_NODE:
+        case F_COPY:
+        case F_ASSIGN:
+        case F_REVERSE:     return 2 * (n + 1) * (n + 1) + (n + 1) * per_node; // O(n^2)
+        default:            return 0;                     // nessuna copia
+    }
+}
+
+/**
+ Confronta un grafo con il modello: numero di nodi e archi, ordine di
+ iterazione, gradi, hasEdge su tutte le coppie e, se l'indice inverso è
+ attivo, i predecessori.
+
+ @brief Confronto tra grafo e modello
+
+ @return true se grafo e modello coincidono.
+ */
+static bool check(graphtest &g, const model &m) {
+    if (g.num_nodes() != (int)m.nodes.size() || g.num_edges() != (int)m.edges.size())
+        return false;
+    std::vector<int> order(g.begin(), g.end());
+    if (order != m.nodes)
+        return false;
+    for (unsigned int i = 0; i < m.nodes.size(); i++) {
+        const int a = m.nodes[i];
+        int out = 0, in = 0;
+        for (unsigned int j = 0; j < m.nodes.size(); j++) {
+            const int b = m.nodes[j];
+            const bool e = m.edges.count(std::make_pair(a, b)) != 0;
+            if (g.hasEdge(a, b) != e)
+                return false;
+            out += e;
+            in += m.edges.count(std::make_pair(b, a)) != 0;
+        }
+        if (g.outDegree(a) != out || g.inDegree(a) != in)
+            return false;
+        if (g.hasReverseIndex()) {
+            std::vector<int> pred = g.predecessors(a);
+            if ((int)pred.size() != in)
+                return false;
+            for (unsigned int k = 0; k < pred.size(); k++) {
+                if (m.edges.count(std::make_pair(pred[k], a)) == 0)
+                    return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Somma i costi di due grafi, per le operazioni che li modificano entrambi
+static graph_stats total(const graph_stats &x, const graph_stats &y) {
+    graph_stats t = x;
+    t.eql_calls += y.eql_calls;
+    t.allocations += y.allocations;
+    t.bytes_allocated += y.bytes_allocated;
+    t.bytes_copied += y.bytes_copied;
+    return t;
+}
+
+/**
+ Verifica che i contatori vedano le copie: copia e assegnamento di un grafo
+ non vuoto devono contare byte copiati, altrimenti i limiti di costo non
+ controllerebbero nulla.
+
+ @brief Verifica della misura del costo
+
+ @return true se copia e assegnamento sono misurati.
+ */
+static bool cost_probe() {
+    graphtest src, dst;
+    for (int i = 0; i < 8; i++)
+        src.addNode(i);
+    src.addEdge(0, 1);
+    graphtest copy(src);
+    dst = src;
+    return copy.stats().bytes_copied > 0 && dst.stats().bytes_copied > 0;
+}
+
+// Esegue un'operazione sul grafo e ritorna il codice dell'eccezione (0 se nessuna)
+template <typename F>
+static int run(F f) {
+    try {
+        f();
+    } catch (customException &e) {
+        return e.get_value();
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    const unsigned long long seed = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1;
+    const long steps = argc > 2 ? std::strtol(argv[2], nullptr, 10) : 5000;
+    const int values = 48;   // valori dei nodi in [0, values): molte collisioni
+
+    std::cout << "******** Fuzz differenziale del grafo (seme " << seed << ", " << steps << " passi) ********" << std::endl;
+
+    if (!cost_probe()) {
+        std::cout << "ERRORE: copia e assegnamento non sono misurati dalle statistiche" << std::endl;
+        return 1;
+    }
+
+    rng r(seed);
+    graphtest g[2];
+    model m[2];
+    unsigned long long calls[F_COUNT] = {0};
+    double worst[F_COUNT] = {0};   // massimo rapporto costo / limite
+    long failures = 0, violations = 0;
+
+    for (long step = 0; step < steps && failures == 0; step++) {
+        const int k = r.next(2);
+        graphtest &gr = g[k];
+        model &mo = m[k];
+        // più inserimenti che rimozioni, così il grafo cresce fino a ~values nodi
+        const unsigned int dice = r.next(100);
+        int op;
+        if (dice < 14)       op = F_ADD_NODE;
+        else if (dice < 20)  op = F_REMOVE_NODE;
+        else if (dice < 50)  op = F_ADD_EDGE;
+        else if (dice < 65)  op = F_REMOVE_EDGE;
+        else if (dice < 90)  op = F_HAS_EDGE;
+        else if (dice < 93)  op = F_COPY;
+        else if (dice < 96)  op = F_ASSIGN;
+        else if (dice < 99)  op = F_SWAP;
+        else                 op = F_REVERSE;
+        const int a = r.next(values), b = r.next(values);
+        const unsigned long long n = gr.num_nodes();
+
+        gr.resetStats();
+        g[1 - k].resetStats();
+        int expected = 0, got = 0;
+        graph_stats cost;
+        switch (op) {
+            case F_ADD_NODE:
+                expected = mo.addNode(a);
+                got = run([&]() { gr.addNode(a); });
+                cost = gr.stats();
+                break;
+            case F_REMOVE_NODE:
+                expected = mo.removeNode(a);
+                got = run([&]() { gr.removeNode(a); });
+                cost = gr.stats();
+                break;
+            case F_ADD_EDGE:
+                expected = mo.addEdge(a, b);
+                got = run([&]() { gr.addEdge(a, b); });
+                cost = gr.stats();
+                break;
+            case F_REMOVE_EDGE:
+                expected = mo.removeEdge(a, b);
+                got = run([&]() { gr.removeEdge(a, b); });
+                cost = gr.stats();
+                break;
+            case F_HAS_EDGE: {
+                bool result = false;
+                expected = (mo.exists(a) && mo.exists(b)) ? 0 : 993;
+                got = run([&]() { result = gr.hasEdge(a, b); });
+                cost = gr.stats();
+                if (got == 0 && result != (mo.edges.count(std::make_pair(a, b)) != 0))
+                    got = -1;
+                break;
+            }
+            case F_COPY: {
+                graphtest copy(gr);
+                cost = copy.stats();
+                if (!check(copy, mo))
+                    got = -1;
+                break;
+            }
+            case F_ASSIGN:
+                g[1 - k] = gr;
+                m[1 - k] = mo;
+                cost = total(gr.stats(), g[1 - k].stats());
+                break;
+            case F_SWAP:
+                gr.swap(g[1 - k]);
+                std::swap(mo, m[1 - k]);
+                cost = total(gr.stats(), g[1 - k].stats());
+                break;
+            case F_REVERSE:
+                if (gr.hasReverseIndex())
+                    gr.disableReverseIndex();
+                else
+                    gr.enableReverseIndex();
+                cost = gr.stats();
+                break;
+        }
+        calls[op]++;
+
+        // assign e swap modificano entrambi i grafi, le altre solo il grafo k
+        const bool both = op == F_ASSIGN || op == F_SWAP;
+        if (got != expected || !check(gr, mo) || (both && !check(g[1 - k], m[1 - k]))) {
+            std::cout << "ERRORE al passo " << step << ": " << op_names[op] << "(" << a << ", " << b
+                      << ") sul grafo " << k << ", eccezione attesa " << expected << ", ottenuta " << got << std::endl;
+            failures++;
+        }
+
+        const unsigned long long eb = eql_bound(op, n), cb = copy_bound(op, n);
+        if (cost.eql_calls > eb || cost.bytes_copied > cb) {
+            if (violations < 10) {
+                std::cout << "COSTO al passo " << step << ": " << op_names[op] << " con " << n << " nodi, "
+                          << cost.eql_calls << " uguaglianze (limite " << eb << "), "
+                          << cost.bytes_copied << " byte copiati (limite " << cb << ")" << std::endl;
+            }
+            violations++;
+        }
+        if (eb > 0)
+            worst[op] = std::max(worst[op], (double)cost.eql_calls / eb);
+        if (cb > 0)
+            worst[op] = std::max(worst[op], (double)cost.bytes_copied / cb);
+    }
+
+    for (int op = 0; op < F_COUNT; op++) {
+        std::cout << op_names[op] << ": " << calls[op] << " chiamate, costo massimo "
+                  << (int)(worst[op] * 100) << "% del limite" << std::endl;
+    }
+    std::cout << "errori: " << failures << ", violazioni di costo: " << violations << std::endl;
+    return (failures == 0 && violations == 0) ? 0 : 1;
+}
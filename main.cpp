@@ -7,7 +7,23 @@
 
 #include <iostream>
 #include "Graph.hpp"
+#include "GraphView.hpp"
+#include "QueryExecutor.hpp"
+#include "InternedGraph.hpp"
+#include "MultiGraph.hpp"
+#include "VersionedGraph.hpp"
+#include "PartitionedGraph.hpp"
 #include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include <limits>
+#include <cstdio>
+#include <sstream>
+#include <type_traits>
+#include <memory>
+#include <chrono>
+#include <thread>
 
 /**
  Funtore per valutare l'uguaglianza tra interi. La valutazione e'
@@ -21,6 +37,34 @@ struct equal_int {
     }
 };
 
+/**
+ Funtore di uguaglianza tra interi che lancia un'eccezione standard sul
+ valore -1, per simulare un errore durante l'esecuzione di un'interrogazione.
+
+ @brief Funtore di uguaglianza tra interi che fallisce su -1.
+ */
+struct equal_int_throwing {
+    bool operator()(int a, int b) const {
+        if (a == -1 || b == -1)
+            throw std::runtime_error("confronto non riuscito");
+        return a==b;
+    }
+};
+
+/**
+ Funtore di uguaglianza tra interi che conta le chiamate.
+
+ @brief Funtore di uguaglianza tra interi con contatore.
+ */
+struct equal_int_counting {
+    static unsigned long calls;
+    bool operator()(int a, int b) const {
+        ++calls;
+        return a==b;
+    }
+};
+unsigned long equal_int_counting::calls = 0;
+
 // Typedef della classe grafo su interi di comodo
 typedef Graph<int, equal_int> graphtest;
 
@@ -174,6 +218,1052 @@ void test_eccezioni_interi(){
     
 }
 
+/**
+ Test di diff e applyPatch sul grafo di interi
+ 
+ @brief Test di diff e applyPatch
+ */
+void test_diff_patch_interi() {
+    std::cout<<"******** Test diff/patch del grafo di interi ********"<<std::endl;
+    
+    graphtest src, dst;
+    try {
+        for (int i = 0; i < 6; i++) {
+            src.addNode(i);
+            dst.addNode(i);
+        }
+        src.addEdge(0, 1);
+        src.addEdge(1, 2);
+        src.addEdge(3, 4);
+        dst.addEdge(0, 1);
+        dst.addEdge(2, 1);
+        dst.removeNode(4);
+        dst.addNode(10);
+        dst.addEdge(10, 0);
+        dst.addEdge(5, 10);
+    } catch (customException &m) {
+        std::cout << m.get_value() << " " << m.get_error() << std::endl;
+        return;
+    }
+    
+    graphtest::patch p = src.diff(dst);
+    assert(p.removed_nodes.size() == 1);
+    assert(p.added_nodes.size() == 1);
+    assert(p.removed_edges.size() == 1); // 1->2 (3->4 sparisce col nodo 4)
+    assert(p.added_edges.size() == 3);   // 2->1, 10->0, 5->10
+    
+    // Formato binario: la patch letta coincide, a meno dell'ordine degli archi
+    std::ostringstream wire;
+    graphtest::writePatch(p, wire);
+    std::istringstream in(wire.str());
+    graphtest::patch q = graphtest::readPatch(in);
+    assert(q.removed_nodes == p.removed_nodes && q.added_nodes == p.added_nodes);
+    std::sort(p.added_edges.begin(), p.added_edges.end());
+    std::sort(p.removed_edges.begin(), p.removed_edges.end());
+    assert(q.added_edges == p.added_edges && q.removed_edges == p.removed_edges);
+    // Serializzatore dei nodi fornito dal chiamante: un byte per nodo
+    std::ostringstream raw;
+    graphtest::writePatch(p, raw, [](graph_writer &w, const int &v) { w.put((char)v); });
+    std::istringstream raw_in(raw.str());
+    graphtest::patch r = graphtest::readPatch(raw_in, [](std::istream &is) { return is.get(); });
+    assert(r.added_nodes == p.added_nodes && r.added_edges == p.added_edges);
+    assert(raw.str().size() < wire.str().size());
+    std::istringstream truncated(wire.str().substr(0, wire.str().size() - 1));
+    try {
+        graphtest::readPatch(truncated);
+        assert(false);
+    } catch (customException &m) {
+        std::cout << m.get_value() << " " << m.get_error() << std::endl;
+    }
+    
+    src.applyPatch(q);
+    assert(src.num_nodes() == dst.num_nodes());
+    assert(src.num_edges() == dst.num_edges());
+    graphtest::const_iterator i, ie, j, je;
+    for (i = dst.begin(), ie = dst.end(); i != ie; ++i)
+        for (j = dst.begin(), je = dst.end(); j != je; ++j)
+            assert(src.hasEdge(*i, *j) == dst.hasEdge(*i, *j));
+    for (i = dst.begin(), ie = dst.end(); i != ie; ++i)
+        assert(src.inDegree(*i) == dst.inDegree(*i) && src.outDegree(*i) == dst.outDegree(*i));
+    assert(src.diff(dst).empty());
+    
+    // Una patch non valida non deve modificare il grafo
+    try {
+        src.applyPatch(p);
+        assert(false);
+    } catch (customException &m) {
+        std::cout << m.get_value() << " " << m.get_error() << std::endl;
+    }
+    assert(src.num_nodes() == dst.num_nodes());
+    
+    // Archi ripetuti nella stessa lista: rifiutati senza alterare i gradi
+    const int edges = src.num_edges();
+    graphtest::patch dup;
+    dup.removed_edges.push_back(std::make_pair(0, 1));
+    dup.removed_edges.push_back(std::make_pair(0, 1));
+    try {
+        src.applyPatch(dup);
+        assert(false);
+    } catch (customException &m) {
+        std::cout << m.get_value() << " " << m.get_error() << std::endl;
+    }
+    dup.removed_edges.clear();
+    dup.added_edges.push_back(std::make_pair(1, 3));
+    dup.added_edges.push_back(std::make_pair(1, 3));
+    try {
+        src.applyPatch(dup);
+        assert(false);
+    } catch (customException &m) {
+        std::cout << m.get_value() << " " << m.get_error() << std::endl;
+    }
+    assert(src.num_edges() == edges && src.outDegree(1) == dst.outDegree(1));
+    assert(src.inDegree(1) == dst.inDegree(1) && !src.hasEdge(1, 3));
+}
+
+/**
+ Test di PageRank e centralità di grado sul grafo di interi
+ 
+ @brief Test di PageRank e centralità di grado
+ */
+void test_pagerank_interi() {
+    std::cout<<"******** Test PageRank del grafo di interi ********"<<std::endl;
+    
+    graphtest ring;
+    try {
+        for (int i = 0; i < 4; i++)
+            ring.addNode(i);
+        for (int i = 0; i < 4; i++)
+            ring.addEdge(i, (i + 1) % 4);
+    } catch (customException &m) {
+        std::cout << m.get_value() << " " << m.get_error() << std::endl;
+        return;
+    }
+    std::vector<double> r = ring.pageRank(0.85, 1e-12, 100, 2);
+    for (int i = 0; i < 4; i++)
+        assert(std::fabs(r[i] - 0.25) < 1e-9);
+    
+    // Stella: tutti i nodi puntano a 0, che non ha archi uscenti
+    graphtest star;
+    try {
+        for (int i = 0; i < 5; i++)
+            star.addNode(i);
+        for (int i = 1; i < 5; i++)
+            star.addEdge(i, 0);
+    } catch (customException &m) {
+        std::cout << m.get_value() << " " << m.get_error() << std::endl;
+        return;
+    }
+    std::vector<double> s1 = star.pageRank(0.85, 1e-12, 200, 1);
+    std::vector<double> s4 = star.pageRank(0.85, 1e-12, 200, 4);
+    double sum = 0;
+    for (int i = 0; i < 5; i++) {
+        sum += s1[i];
+        assert(std::fabs(s1[i] - s4[i]) < 1e-12);
+        if (i > 0)
+            assert(s1[0] > s1[i]);
+    }
+    assert(std::fabs(sum - 1.0) < 1e-9);
+    
+    std::vector<double> in, out;
+    star.degreeCentrality(in, out);
+    assert(in[0] == 1.0 && out[0] == 0.0);
+    assert(in[1] == 0.0 && out[1] == 0.25);
+    
+    try {
+        star.pageRank(1.5);
+    } catch (customException &m) {
+        std::cout << m.get_value() << " " << m.get_error() << std::endl;
+    }
+}
+
+/**
+ Test dei gradi entranti e uscenti sul grafo di interi
+ 
+ @brief Test dei gradi dei nodi
+ */
+void test_gradi_interi() {
+    std::cout<<"******** Test gradi del grafo di interi ********"<<std::endl;
+    
+    graphtest graph;
+    try {
+        for (int i = 0; i < 4; i++)
+            graph.addNode(i);
+        graph.addEdge(0, 1);
+        graph.addEdge(0, 2);
+        graph.addEdge(2, 1);
+        graph.addEdge(3, 3);
+    } catch (customException &m) {
+        std::cout << m.get_value() << " " << m.get_error() << std::endl;
+        return;
+    }
+    assert(graph.outDegree(0) == 2 && graph.inDegree(0) == 0);
+    assert(graph.inDegree(1) == 2 && graph.outDegree(1) == 0);
+    assert(graph.inDegree(3) == 1 && graph.outDegree(3) == 1);
+    
+    graph.removeEdge(0, 2);
+    assert(graph.outDegree(0) == 1 && graph.inDegree(2) == 0);
+    
+    graph.removeNode(2);
+    assert(graph.inDegree(1) == 1);
+    
+    graph.addNode(7);
+    graph.addEdge(7, 1);
+    graphtest copy(graph);
+    std::vector<int> in, out;
+    copy.degrees(in, out);
+    assert(in.size() == 4);
+    assert(in[1] == 2 && out[3] == 1); // ordine: 0, 1, 3, 7
+    
+    try {
+        graph.inDegree(42);
+    } catch (customException &m) {
+        std::cout << m.get_value() << " " << m.get_error() << std::endl;
+    }
+}
+
+/**
+ Predicato che seleziona gli interi pari.
+ 
+ @brief Predicato per gli interi pari.
+ */
+struct is_even {
+    bool operator()(int a) const {
+        return a % 2 == 0;
+    }
+};
+
+/**
+ Test della vista sul sottografo indotto del grafo di interi
+ 
+ @brief Test della vista sul sottografo indotto
+ */
+void test_vista_interi() {
+    std::cout<<"******** Test vista del grafo di interi ********"<<std::endl;
+    
+    graphtest graph;
+    try {
+        for (int i = 0; i < 6; i++)
+            graph.addNode(i);
+        graph.addEdge(0, 2);
+        graph.addEdge(2, 4);
+        graph.addEdge(4, 0);
+        graph.addEdge(1, 2);
+        graph.addEdge(4, 5);
+    } catch (customException &m) {
+        std::cout << m.get_value() << " " << m.get_error() << std::endl;
+        return;
+    }
+    
+    GraphView<int, equal_int> even(graph, is_even());
+    assert(even.num_nodes() == 3);
+    assert(even.num_edges() == 3);
+    assert(even.exists(2) && !even.exists(1));
+    assert(even.hasEdge(2, 4));
+    assert(even.inDegree(2) == 1 && even.outDegree(4) == 1);
+    
+    GraphView<int, equal_int>::const_iterator it, ite;
+    int expected = 0;
+    for (it = even.begin(), ite = even.end(); it != ite; ++it) {
+        assert(*it == expected);
+        expected += 2;
+    }
+    
+    graphtest sub = even.materialize();
+    assert(sub.num_nodes() == 3);
+    assert(sub.num_edges() == 3);
+    assert(sub.hasEdge(4, 0) && !sub.hasEdge(0, 4));
+    assert(sub.inDegree(0) == 1 && sub.outDegree(0) == 1);
+    
+    try {
+        even.hasEdge(1, 2);
+    } catch (customException &m) {
+        std::cout << m.get_value() << " " << m.get_error() << std::endl;
+    }
+}
+
+/**
+ Test del grafo trasposto e dell'indice inverso sul grafo di interi
+ 
+ @brief Test di trasposizione e indice inverso
+ */
+void test_trasposto_interi() {
+    std::cout<<"******** Test trasposto del grafo di interi ********"<<std::endl;
+    
+    graphtest graph;
+    try {
+        for (int i = 0; i < 70; i++)  // piu' di un blocco di trasposizione
+            graph.addNode(i);
+        for (int i = 0; i < 70; i++)
+            graph.addEdge(i, (i * 3 + 1) % 70);
+        graph.addEdge(5, 69);
+    } catch (customException &m) {
+        std::cout << m.get_value() << " " << m.get_error() << std::endl;
+        return;
+    }
+    
+    graphtest t = graph.transpose();
+    assert(t.num_edges() == graph.num_edges());
+    for (int i = 0; i < 70; i++)
+        assert(t.hasEdge((i * 3 + 1) % 70, i));
+    assert(t.hasEdge(69, 5) && !t.hasEdge(5, 69));
+    assert(t.outDegree(69) == graph.inDegree(69));
+    
+    std::vector<int> before = graph.predecessors(69);
+    graph.enableReverseIndex();
+    assert(graph.hasReverseIndex());
+    assert(graph.predecessors(69) == before);
+    
+    // L'indice deve restare coerente dopo le modifiche
+    graph.removeEdge(5, 69);
+    graph.addNode(100);
+    graph.addEdge(100, 69);
+    graph.removeNode(3);
+    graphtest copy(graph);
+    assert(copy.hasReverseIndex());
+    std::vector<int> p = copy.predecessors(69);
+    assert(p.size() == 2 && p[0] == 46 && p[1] == 100);
+    assert(copy.successors(100).size() == 1);
+    
+    graphtest rt = copy.transpose();
+    assert(rt.successors(69) == p);
+    
+    graph.disableReverseIndex();
+    assert(graph.predecessors(69) == p);
+}
+
+/**
+ Test delle statistiche sul grafo di interi. Con la politica collect_stats i
+ contatori devono crescere, con quella di default devono restare a zero.
+ 
+ @brief Test delle statistiche del grafo
+ */
+void test_statistiche_interi() {
+    std::cout<<"******** Test statistiche del grafo di interi ********"<<std::endl;
+    
+    Graph<int, equal_int, collect_stats> graph;
+    graphtest plain;  // politica di default: nessun contatore
+    try {
+        graph.addNode(1);
+        graph.addNode(2);
+        plain.addNode(1);
+        plain.addNode(2);
+        plain.addEdge(1, 2);
+        graph.addEdge(1, 2);
+        graph.addEdge(1, 2);
+    } catch (customException &m) {
+        std::cout << m.get_value() << " " << m.get_error() << std::endl;
+    }
+    graph_stats s = graph.stats();
+    assert(s.calls[OP_ADD_NODE] == 2);
+    assert(s.calls[OP_ADD_EDGE] == 2);
+    assert(s.exceptions == 1);
+    assert(s.eql_calls > 0);
+    assert(s.allocations > 0 && s.bytes_copied > 0);
+    graph.resetStats();
+    assert(graph.stats().eql_calls == 0);
+    
+    // l'assegnamento conta la copia fatta sul grafo temporaneo
+    Graph<int, equal_int, collect_stats> target;
+    target = graph;
+    assert(target.stats().bytes_copied > 0 && target.stats().allocations > 0);
+    
+    s = plain.stats();
+    assert(s.calls[OP_ADD_NODE] == 0 && s.eql_calls == 0 && s.exceptions == 0);
+    // la politica di default non occupa memoria nel grafo
+    assert(sizeof(graphtest) < sizeof(Graph<int, equal_int, collect_stats>));
+    plain.dumpStats(std::cout);
+    graph.dumpStats(std::cout);
+}
+
+/**
+ Calcola la banda della matrice di adiacenza: la massima distanza tra le
+ posizioni di due nodi collegati da un arco.
+ */
+int banda(graphtest &graph) {
+    std::vector<int> order(graph.begin(), graph.end());
+    int band = 0;
+    for (unsigned int i = 0; i < order.size(); i++)
+        for (unsigned int j = 0; j < order.size(); j++)
+            if (graph.hasEdge(order[i], order[j]))
+                band = std::max(band, std::abs((int)i - (int)j));
+    return band;
+}
+
+/**
+ Test del riordinamento dei nodi del grafo di interi
+ 
+ @brief Test del riordinamento dei nodi
+ */
+void test_riordinamento_interi() {
+    std::cout<<"******** Test riordinamento del grafo di interi ********"<<std::endl;
+    
+    // Cammino 0-1-2-...-9 con i nodi inseriti in ordine sparso
+    graphtest graph;
+    const int ins[10] = { 4, 9, 0, 7, 2, 5, 1, 8, 3, 6 };
+    try {
+        for (int i = 0; i < 10; i++)
+            graph.addNode(ins[i]);
+        for (int i = 0; i < 9; i++)
+            graph.addEdge(i, i + 1);
+    } catch (customException &m) {
+        std::cout << m.get_value() << " " << m.get_error() << std::endl;
+        return;
+    }
+    assert(banda(graph) > 1);
+    
+    graphtest rcm(graph);
+    rcm.enableReverseIndex();
+    rcm.reorder(ORDER_RCM);
+    assert(banda(rcm) == 1);
+    assert(rcm.num_edges() == 9);
+    for (int i = 0; i < 9; i++)
+        assert(rcm.hasEdge(i, i + 1) && !rcm.hasEdge(i + 1, i));
+    assert(rcm.predecessors(5).size() == 1 && rcm.predecessors(5)[0] == 4);
+    assert(rcm.outDegree(0) == 1 && rcm.inDegree(0) == 0);
+    
+    graphtest bfs(graph);
+    bfs.reorder(ORDER_BFS);
+    assert(banda(bfs) <= 2);
+    
+    graphtest deg(graph);
+    deg.reorder(ORDER_DEGREE);
+    assert(*deg.begin() != 0 && *deg.begin() != 9);
+    
+    // Cammino non orientato 0-1-2-3 con un cappio su 0 e la coppia 0<->1:
+    // cappi e archi opposti non aumentano il grado usato dall'ordinamento
+    graphtest loops;
+    for (int i = 0; i < 4; i++)
+        loops.addNode(i);
+    loops.addEdge(0, 0);
+    loops.addEdge(0, 1);
+    loops.addEdge(1, 0);
+    loops.addEdge(2, 1);
+    loops.addEdge(2, 3);
+    const int by_degree[4] = { 1, 2, 0, 3 };
+    const int by_rcm[4] = { 3, 2, 1, 0 };
+    assert(loops.ordering(ORDER_DEGREE) == std::vector<int>(by_degree, by_degree + 4));
+    assert(loops.ordering(ORDER_RCM) == std::vector<int>(by_rcm, by_rcm + 4));
+    
+    std::vector<int> wrong(10, 0);
+    try {
+        graph.permute(wrong);
+    } catch (customException &m) {
+        std::cout << m.get_value() << " " << m.get_error() << std::endl;
+    }
+}
+
+/**
+ Test della copia parallela e della rimozione di tutti gli archi
+ 
+ @brief Test delle operazioni parallele sul grafo
+ */
+void test_parallelo_interi() {
+    std::cout<<"******** Test operazioni parallele del grafo di interi ********"<<std::endl;
+    
+    graphtest graph;
+    try {
+        for (int i = 0; i < 50; i++)
+            graph.addNode(i);
+        for (int i = 0; i < 50; i++)
+            for (int j = 0; j < 50; j += 1 + i % 7)
+                graph.addEdge(i, j);
+    } catch (customException &m) {
+        std::cout << m.get_value() << " " << m.get_error() << std::endl;
+        return;
+    }
+    graph.enableReverseIndex();
+    
+    graphtest copy(graph, 4);
+    assert(copy.num_nodes() == graph.num_nodes());
+    assert(copy.num_edges() == graph.num_edges());
+    assert(copy.diff(graph).empty());
+    assert(copy.hasReverseIndex());
+    assert(copy.predecessors(49) == graph.predecessors(49));
+    
+    copy.clearEdges(4);
+    assert(copy.num_nodes() == 50);
+    assert(copy.num_edges() == 0);
+    assert(copy.predecessors(0).empty());
+    assert(copy.outDegree(3) == 0);
+    assert(graph.num_edges() > 0);
+    
+    // Tempi con 1 thread e con tutti i core, su un grafo più grande
+    graphtest::patch p;
+    const int n = 2000;
+    for (int i = 0; i < n; i++) {
+        p.added_nodes.push_back(i);
+        p.added_edges.push_back(std::make_pair(i, (i * 13 + 5) % n));
+    }
+    graphtest big;
+    big.applyPatch(p);
+    unsigned int cores = std::thread::hardware_concurrency();
+    if (cores < 2)
+        cores = 2;
+    double copy_time[2], clear_time[2];
+    for (int k = 0; k < 2; k++) {
+        const unsigned int threads = k == 0 ? 1 : cores;
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        graphtest c(big, threads);
+        std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+        c.clearEdges(threads);
+        std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+        assert(c.num_edges() == 0);
+        copy_time[k] = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        clear_time[k] = std::chrono::duration<double, std::milli>(t2 - t1).count();
+    }
+    std::cout << "copia " << n << " nodi: " << copy_time[0] << " ms con 1 thread, "
+              << copy_time[1] << " ms con " << cores << " (speedup " << copy_time[0] / copy_time[1] << ")" << std::endl;
+    std::cout << "clearEdges " << n << " nodi: " << clear_time[0] << " ms con 1 thread, "
+              << clear_time[1] << " ms con " << cores << " (speedup " << clear_time[0] / clear_time[1] << ")" << std::endl;
+}
+
+/**
+ Test del conteggio dei triangoli e del coefficiente di clustering
+ 
+ @brief Test di triangoli e clustering
+ */
+void test_triangoli_interi() {
+    std::cout<<"******** Test triangoli del grafo di interi ********"<<std::endl;
+    
+    // Cricca di 4 nodi (0..3) con archi in un solo verso, piu' un nodo 4
+    // collegato solo a 0 e un cappio ignorato
+    graphtest graph;
+    try {
+        for (int i = 0; i < 5; i++)
+            graph.addNode(i);
+        for (int i = 0; i < 4; i++)
+            for (int j = i + 1; j < 4; j++)
+                graph.addEdge(i, j);
+        graph.addEdge(1, 0); // arco opposto: stessa coppia non orientata
+        graph.addEdge(4, 0);
+        graph.addEdge(2, 2);
+    } catch (customException &m) {
+        std::cout << m.get_value() << " " << m.get_error() << std::endl;
+        return;
+    }
+    assert(graph.triangles(1) == 4);
+    assert(graph.triangles(3) == 4);
+    
+    std::vector<double> c = graph.clustering(2);
+    assert(std::fabs(c[0] - 0.5) < 1e-12); // 3 triangoli su 6 coppie
+    assert(c[1] == 1.0 && c[3] == 1.0);
+    assert(c[4] == 0.0);
+    
+    // Anello con corde: 200 nodi usano il percorso a bit, 1000 nodi
+    // (pochi vicini rispetto alla lunghezza delle righe) quello sparso
+    const int sizes[2] = { 200, 1000 };
+    for (int s = 0; s < 2; s++) {
+        graphtest big;
+        graphtest::patch p;
+        for (int i = 0; i < sizes[s]; i++) {
+            p.added_nodes.push_back(i);
+            p.added_edges.push_back(std::make_pair(i, (i + 1) % sizes[s]));
+            p.added_edges.push_back(std::make_pair(i, (i + 2) % sizes[s]));
+        }
+        big.applyPatch(p);
+        assert(big.triangles(4) == sizes[s]);
+        assert(std::fabs(big.clustering(1)[7] - 0.5) < 1e-12);
+    }
+}
+
+/**
+ Test delle operazioni di algebra booleana sul grafo di interi, confrontate
+ con il calcolo diretto sulle matrici di adiacenza
+ 
+ @brief Test delle operazioni di algebra booleana sul grafo di interi
+ */
+void test_algebra_interi() {
+    std::cout<<"******** Test algebra booleana del grafo di interi ********"<<std::endl;
+    
+    // a: nodi 0..129, b: nodi 30..159 (in ordine inverso), archi pseudocasuali
+    const int n = 130;
+    graphtest a, b;
+    graphtest::patch pa, pb;
+    for (int i = 0; i < n; i++) {
+        pa.added_nodes.push_back(i);
+        pb.added_nodes.push_back(159 - i);
+    }
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            if ((i * 31 + j * 17) % 23 == 0)
+                pa.added_edges.push_back(std::make_pair(i, j));
+            if ((i * 13 + j * 7) % 29 == 0)
+                pb.added_edges.push_back(std::make_pair(i, j));
+        }
+    }
+    a.applyPatch(pa);
+    b.applyPatch(pb);
+    
+    // matrici di riferimento indicizzate per valore (0..159)
+    const int m = 160;
+    std::vector<std::vector<char> > ma(m, std::vector<char>(m, 0)), mb = ma;
+    for (int i = 0; i < m; i++) {
+        for (int j = 0; j < m; j++) {
+            ma[i][j] = i < n && j < n && a.hasEdge(i, j);
+            mb[i][j] = i >= 30 && j >= 30 && b.hasEdge(i, j);
+        }
+    }
+    
+    graphtest u = a.graphUnion(b);
+    graphtest in = a.graphIntersection(b);
+    graphtest d = a.graphDifference(b);
+    graphtest c = a.compose(b, 3);
+    assert(u.num_nodes() == m && in.num_nodes() == n - 30 && d.num_nodes() == n);
+    assert(c.num_nodes() == m);
+    int edges_u = 0, edges_i = 0, edges_d = 0, edges_c = 0;
+    for (int i = 0; i < m; i++) {
+        for (int j = 0; j < m; j++) {
+            bool comp = false;
+            for (int k = 0; k < m && !comp; k++)
+                comp = ma[i][k] && mb[k][j];
+            assert(u.hasEdge(i, j) == (ma[i][j] || mb[i][j]));
+            assert(c.hasEdge(i, j) == comp);
+            edges_u += ma[i][j] || mb[i][j];
+            edges_c += comp;
+            if (i < n && j < n) {
+                assert(d.hasEdge(i, j) == (ma[i][j] && !mb[i][j]));
+                edges_d += ma[i][j] && !mb[i][j];
+            }
+            if (i >= 30 && j >= 30 && i < n && j < n) {
+                assert(in.hasEdge(i, j) == (ma[i][j] && mb[i][j]));
+                edges_i += ma[i][j] && mb[i][j];
+            }
+        }
+    }
+    assert(u.num_edges() == edges_u && in.num_edges() == edges_i);
+    assert(d.num_edges() == edges_d && c.num_edges() == edges_c);
+    
+    // Cammino 0->1->...->9: potenze e adiacenza a k passi
+    graphtest path;
+    for (int i = 0; i < 10; i++)
+        path.addNode(i);
+    for (int i = 0; i < 9; i++)
+        path.addEdge(i, i + 1);
+    graphtest p0 = path.power(0);
+    graphtest p3 = path.power(3, 2);
+    graphtest h3 = path.kHop(3);
+    assert(p0.num_edges() == 10 && p0.hasEdge(4, 4));
+    assert(p3.num_edges() == 7 && p3.hasEdge(2, 5) && !p3.hasEdge(2, 4));
+    assert(h3.num_edges() == 9 + 8 + 7 && h3.hasEdge(2, 4) && h3.hasEdge(2, 5));
+    assert(!h3.hasEdge(2, 6) && !h3.hasEdge(2, 2));
+    assert(path.kHop(0).num_edges() == 0);
+    
+    // Su un ciclo di 5 nodi il nodo ritorna su se stesso dopo 5 passi
+    path.addEdge(9, 0);
+    path.removeEdge(4, 5);
+    path.addEdge(4, 0);
+    assert(path.kHop(5).hasEdge(0, 0) && !path.kHop(4).hasEdge(0, 0));
+    assert(path.power(10).hasEdge(3, 3) && path.power(7).hasEdge(0, 2));
+    
+    // Più thread che blocchi di colonne: le righe sono divise tra i thread
+    graphtest big;
+    for (int i = 0; i < 600; i++)
+        big.addNode(i);
+    for (int i = 0; i < 600; i++) {
+        big.addEdge(i, (i * 37 + 11) % 600);
+        big.addEdge(i, (i + 1) % 600);
+    }
+    graphtest sq1 = big.power(2, 1);
+    assert(sq1.diff(big.power(2, 4)).empty());
+    assert(sq1.hasEdge(0, 2) && sq1.hasEdge(0, 12) && sq1.num_edges() <= 4 * 600);
+    
+    try {
+        path.power(-1);
+    } catch (customException &m) {
+        std::cout << m.get_value() << " " << m.get_error() << std::endl;
+    }
+}
+
+/**
+ Test della colorazione e dell'insieme indipendente sul grafo di interi
+ 
+ @brief Test della colorazione e dell'insieme indipendente sul grafo di interi
+ */
+void test_colorazione_interi() {
+    std::cout<<"******** Test colorazione del grafo di interi ********"<<std::endl;
+    
+    const graph_coloring methods[3] = { COLOR_DSATUR, COLOR_LARGEST_FIRST, COLOR_JONES_PLASSMANN };
+    
+    // Ciclo pari di 10 nodi con archi in un solo verso e un cappio ignorato
+    graphtest ring;
+    try {
+        for (int i = 0; i < 10; i++)
+            ring.addNode(i);
+        for (int i = 0; i < 10; i++)
+            ring.addEdge(i, (i + 1) % 10);
+        ring.addEdge(3, 3);
+    } catch (customException &m) {
+        std::cout << m.get_value() << " " << m.get_error() << std::endl;
+        return;
+    }
+    std::vector<int> c = ring.coloring();
+    for (int i = 0; i < 10; i++)
+        assert(c[i] != c[(i + 1) % 10] && c[i] < 2);  // DSatur è ottimo sui grafi bipartiti
+    std::vector<std::vector<int> > waves = ring.colorClasses();
+    assert(waves.size() == 2 && waves[0].size() == 5 && waves[1].size() == 5);
+    
+    // Ciclo dispari: servono 3 colori
+    ring.removeEdge(9, 0);
+    ring.addEdge(8, 0);
+    ring.removeNode(9);
+    c = ring.coloring(COLOR_DSATUR);
+    assert(*std::max_element(c.begin(), c.end()) == 2);
+    
+    // Grafo pseudocasuale di 300 nodi: colorazioni valide, Jones-Plassmann
+    // e insieme indipendente non dipendono dal numero di thread
+    const int n = 300;
+    graphtest big;
+    graphtest::patch p;
+    for (int i = 0; i < n; i++)
+        p.added_nodes.push_back(i);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            if (i != j && (i * 37 + j * 11) % 41 == 0)
+                p.added_edges.push_back(std::make_pair(i, j));
+        }
+    }
+    big.applyPatch(p);
+    int max_deg = 0;
+    for (int i = 0; i < n; i++) {
+        int d = 0;
+        for (int j = 0; j < n; j++)
+            d += big.hasEdge(i, j) || big.hasEdge(j, i);
+        max_deg = std::max(max_deg, d);
+    }
+    for (int m = 0; m < 3; m++) {
+        std::vector<int> col = big.coloring(methods[m], 3);
+        assert(*std::max_element(col.begin(), col.end()) <= max_deg);
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                if (big.hasEdge(i, j))
+                    assert(col[i] != col[j]);
+            }
+        }
+    }
+    assert(big.coloring(COLOR_JONES_PLASSMANN, 1) == big.coloring(COLOR_JONES_PLASSMANN, 4));
+    
+    std::vector<int> mis = big.independentSet(4);
+    assert(mis == big.independentSet(1));
+    std::vector<char> in(n, 0);
+    for (unsigned int k = 0; k < mis.size(); k++)
+        in[mis[k]] = 1;
+    for (int i = 0; i < n; i++) {
+        bool covered = in[i];
+        for (int j = 0; j < n; j++) {
+            if (big.hasEdge(i, j) || big.hasEdge(j, i)) {
+                assert(!(in[i] && in[j]));  // indipendente
+                covered = covered || in[j];
+            }
+        }
+        assert(covered);                    // massimale
+    }
+}
+
+/**
+ Test dell'esecutore asincrono di interrogazioni sul grafo di interi
+ 
+ @brief Test dell'esecutore asincrono
+ */
+void test_esecutore_interi() {
+    std::cout<<"******** Test esecutore asincrono del grafo di interi ********"<<std::endl;
+    
+    graphtest graph;
+    try {
+        for (int i = 0; i < 10; i++)
+            graph.addNode(i);
+        for (int i = 0; i < 4; i++)
+            graph.addEdge(i, i + 1);  // cammino 0 -> 4
+        graph.addEdge(6, 5);
+    } catch (customException &m) {
+        std::cout << m.get_value() << " " << m.get_error() << std::endl;
+        return;
+    }
+    
+    GraphQueryExecutor<int, equal_int> exec(graph, 3, 8, 4);
+    std::vector<std::future<bool> > edges, paths;
+    for (int i = 0; i < 10; i++) {
+        for (int j = 0; j < 10; j++) {
+            edges.push_back(exec.hasEdge(i, j));
+            paths.push_back(exec.reachable(i, j));
+        }
+    }
+    for (int i = 0; i < 10; i++) {
+        for (int j = 0; j < 10; j++) {
+            assert(edges[i * 10 + j].get() == graph.hasEdge(i, j));
+            bool path = (i == j) || (i < j && j <= 4) || (i == 6 && j == 5);
+            assert(paths[i * 10 + j].get() == path);
+        }
+    }
+    
+    std::future<bool> missing = exec.hasEdge(0, 42);
+    try {
+        missing.get();
+        assert(false);
+    } catch (customException &m) {
+        std::cout << m.get_value() << " " << m.get_error() << std::endl;
+    }
+    
+    exec.shutdown();
+    try {
+        exec.hasEdge(0, 1);
+        assert(false);
+    } catch (customException &m) {
+        std::cout << m.get_value() << " " << m.get_error() << std::endl;
+    }
+    
+    // Un errore durante un lotto arriva ai future invece di terminare il processo
+    Graph<int, equal_int_throwing> fragile;
+    fragile.addNode(0);
+    fragile.addNode(1);
+    GraphQueryExecutor<int, equal_int_throwing> guarded(fragile, 1);
+    std::future<bool> failing = guarded.reachable(0, -1);
+    try {
+        failing.get();
+        assert(false);
+    } catch (std::runtime_error &e) {
+        std::cout << e.what() << std::endl;
+    }
+    assert(guarded.hasEdge(0, 1).get() == false);
+}
+
+/**
+ Test del grafo con archi multipli e attributi degli archi
+ 
+ @brief Test del grafo con archi multipli
+ */
+void test_multigrafo_interi() {
+    std::cout<<"******** Test multigrafo di interi ********"<<std::endl;
+    
+    MultiGraph<int, equal_int> graph;
+    const int bytes = graph.addColumn();
+    const int stamp = graph.addColumn(-1);
+    for (int i = 0; i < 4; i++)
+        graph.addNode(i);
+    
+    int e0 = graph.addEdge(0, 1);
+    int e1 = graph.addEdge(0, 1);  // arco parallelo
+    int e2 = graph.addEdge(0, 2);
+    int e3 = graph.addEdge(2, 0);
+    graph.attribute(e0, bytes) = 100;
+    graph.attribute(e1, bytes) = 50;
+    graph.attribute(e2, bytes) = 7;
+    graph.attribute(e3, bytes) = 3;
+    graph.attribute(e1, stamp) = 42;
+    
+    assert(graph.num_edges() == 4);
+    assert(graph.structure().num_edges() == 3);
+    assert(graph.multiplicity(0, 1) == 2);
+    assert(graph.sumOut(0, bytes) == 157);
+    assert(graph.maxOut(0, bytes) == 100);
+    assert(graph.maxOut(0, stamp) == 42);
+    
+    std::vector<int> moved = graph.compact();
+    assert(graph.attribute(moved[e3], bytes) == 3);
+    assert(graph.source(moved[e3]) == 2 && graph.target(moved[e3]) == 0);
+    assert(graph.sumOut(0, bytes) == 157);
+    assert(graph.sumOut(2, bytes) == 3);
+    
+    graph.removeEdge(moved[e0]);
+    assert(graph.multiplicity(0, 1) == 1);
+    assert(graph.hasEdge(0, 1));
+    assert(graph.sumOut(0, bytes) == 57);
+    
+    graph.compact();
+    graph.removeNode(2);
+    assert(graph.num_edges() == 1);
+    assert(graph.sumOut(0, bytes) == 50);
+    assert(graph.maxOut(3, bytes) == std::numeric_limits<long long>::min());
+    assert(graph.structure().num_edges() == 1);
+    
+    try {
+        graph.attribute(5, bytes);
+    } catch (customException &m) {
+        std::cout << m.get_value() << " " << m.get_error() << std::endl;
+    }
+}
+
+/**
+ Test del grafo versionato di interi
+ 
+ @brief Test del grafo versionato
+ */
+void test_versionato_interi() {
+    std::cout<<"******** Test grafo versionato di interi ********"<<std::endl;
+    
+    VersionedGraph<int, equal_int> graph(3);  // checkpoint ogni 3 modifiche
+    std::vector<graphtest> copies(1);         // copia completa di ogni versione
+    try {
+        for (int i = 0; i < 5; i++) {
+            graph.addNode(i);
+            copies.push_back(graph.latest());
+        }
+        for (int i = 0; i < 4; i++) {
+            graph.addEdge(i, i + 1);
+            copies.push_back(graph.latest());
+        }
+        graph.removeEdge(1, 2);
+        copies.push_back(graph.latest());
+        graph.removeNode(3);
+        copies.push_back(graph.latest());
+        graph.addNode(3);
+        copies.push_back(graph.latest());
+        graph.addEdge(3, 0);
+        copies.push_back(graph.latest());
+    } catch (customException &m) {
+        std::cout << m.get_value() << " " << m.get_error() << std::endl;
+        return;
+    }
+    assert(graph.version() == copies.size() - 1);
+    
+    for (unsigned long v = 0; v <= graph.version(); v++) {
+        graphtest snap = graph.snapshot(v);
+        assert(snap.diff(copies[v]).empty() && copies[v].diff(snap).empty());
+        for (int a = 0; a < 5; a++) {
+            assert(graph.exists(a, v) == copies[v].exists(a));
+            for (int b = 0; b < 5; b++) {
+                if (copies[v].exists(a) && copies[v].exists(b))
+                    assert(graph.hasEdge(a, b, v) == copies[v].hasEdge(a, b));
+            }
+        }
+    }
+    assert(graph.hasEdge(2, 3, 9) && !graph.hasEdge(2, 3, 12));
+    
+    // Il checkpoint è ricaricato senza confrontare i suoi nodi a coppie
+    VersionedGraph<int, equal_int_counting> counted(100);
+    for (int i = 0; i < 200; i++)
+        counted.addNode(i);
+    equal_int_counting::calls = 0;
+    assert(counted.snapshot(200).num_nodes() == 200);
+    assert(equal_int_counting::calls < 200);
+    
+    try {
+        graph.hasEdge(0, 1, 100);
+    } catch (customException &m) {
+        std::cout << m.get_value() << " " << m.get_error() << std::endl;
+    }
+}
+
+#ifdef GRAPH_PARTITIONED
+/**
+ File temporaneo creato nella directory dei file temporanei e rimosso
+ all'uscita dal blocco in cui è dichiarato.
+
+ @brief File temporaneo dei test
+ */
+struct temp_file {
+    std::string path;
+    
+    explicit temp_file(const char *prefix) {
+        const char *dir = std::getenv("TMPDIR");
+        std::string pattern = std::string(dir != nullptr ? dir : "/tmp") + "/" + prefix + "XXXXXX";
+        std::vector<char> name(pattern.begin(), pattern.end());
+        name.push_back('\0');
+        int fd = mkstemp(&name[0]);
+        assert(fd >= 0);
+        close(fd);
+        path = &name[0];
+    }
+    
+    ~temp_file() {
+        std::remove(path.c_str());
+    }
+};
+
+/**
+ Test del grafo su disco a tile, confrontato con un Graph in memoria
+ 
+ @brief Test del grafo su disco a tile
+ */
+void test_partizionato_interi() {
+    std::cout<<"******** Test grafo partizionato su disco ********"<<std::endl;
+    
+    temp_file file("partitioned_test_");
+    const std::string &path = file.path;
+    const int n = 150;
+    graphtest ref;
+    {
+        // tile 64x64 (512 byte) e cache di 2 tile: 9 tile in tutto
+        PartitionedGraph graph(path, n, 64, 1024);
+        try {
+            for (int i = 0; i < n; i++)
+                ref.addNode(i);
+            for (int i = 0; i < n; i++) {
+                graph.addEdge(i, (i * 7 + 3) % n);
+                ref.addEdge(i, (i * 7 + 3) % n);
+                if (i % 4 == 0) {
+                    graph.addEdge(i, (i + 70) % n);
+                    ref.addEdge(i, (i + 70) % n);
+                }
+            }
+            graph.removeEdge(0, 3);
+            ref.removeEdge(0, 3);
+        } catch (customException &m) {
+            std::cout << m.get_value() << " " << m.get_error() << std::endl;
+            return;
+        }
+        assert(graph.num_edges() == ref.num_edges());
+        assert(graph.tile_writes() > 0);  // la cache ha dovuto espellere tile
+        for (int a = 0; a < n; a++) {
+            for (int b = 0; b < n; b++)
+                assert(graph.hasEdge(a, b) == ref.hasEdge(a, b));
+        }
+        
+        try {
+            graph.addEdge(1, 10);  // già presente
+        } catch (customException &m) {
+            std::cout << m.get_value() << " " << m.get_error() << std::endl;
+        }
+        try {
+            graph.hasEdge(0, n);
+        } catch (customException &m) {
+            std::cout << m.get_value() << " " << m.get_error() << std::endl;
+        }
+    }
+    
+    // riapertura del file: i tile espulsi e quelli ancora in cache sono su disco
+    std::unique_ptr<PartitionedGraph> reopened = PartitionedGraph::open(path, 1024);
+    PartitionedGraph &graph = *reopened;
+    assert(graph.num_nodes() == n && graph.num_edges() == ref.num_edges());
+    for (int a = 0; a < n; a++) {
+        std::vector<int> succ = graph.successors(a);
+        std::vector<int> expected;
+        for (int b = 0; b < n; b++)
+            if (ref.hasEdge(a, b))
+                expected.push_back(b);
+        assert(succ == expected);
+    }
+    
+    // visita in ampiezza confrontata con una visita sul grafo in memoria
+    std::vector<int> dist = graph.bfs(5);
+    std::vector<int> expected(n, -1), queue(1, 5);
+    expected[5] = 0;
+    for (unsigned int q = 0; q < queue.size(); q++) {
+        for (int b = 0; b < n; b++) {
+            if (ref.hasEdge(queue[q], b) && expected[b] < 0) {
+                expected[b] = expected[queue[q]] + 1;
+                queue.push_back(b);
+            }
+        }
+    }
+    assert(dist == expected);
+    
+    // intestazione con un numero di nodi che non sta in un int
+    temp_file bad("partitioned_bad_");
+    {
+        const long long h[4] = { 0x54504752, 1LL << 40, 64, 0 };
+        FILE *f = std::fopen(bad.path.c_str(), "wb");
+        assert(f != nullptr && std::fwrite(h, sizeof(h), 1, f) == 1);
+        std::fclose(f);
+    }
+    try {
+        PartitionedGraph::open(bad.path, 1024);
+        assert(false);
+    } catch (customException &m) {
+        std::cout << m.get_value() << " " << m.get_error() << std::endl;
+    }
+}
+#endif
+
 //--------------------------------------------------------------------
 
 /**
@@ -340,6 +1430,143 @@ void test_eccezioni_stringhe(){
         return;
     }
 }
+/**
+ Test degli esportatori del grafo di stringhe
+ 
+ @brief Test degli esportatori del grafo
+ */
+void test_esportazione_stringhe() {
+    std::cout<<"******** Test esportazione grafo di stringhe ********"<<std::endl;
+    
+    graphString graph;
+    try {
+        graph.addNode("pippo");
+        graph.addNode("pluto");
+        graph.addNode("a \"b\"");
+        graph.addEdge("pippo", "pluto");
+        graph.addEdge("pluto", "pippo");
+        graph.addEdge("pluto", "a \"b\"");
+    } catch (customException &m) {
+        std::cout << m.get_value() << " " << m.get_error() << std::endl;
+        return;
+    }
+    
+    std::ostringstream matrix, edges, dot, compressed;
+    graph.writeMatrix(matrix);
+    assert(matrix.str() == "0 : 0 1 0 \n1 : 1 0 1 \n2 : 0 0 0 \n");
+    graph.writeEdgeList(edges);
+    assert(edges.str() == "pippo pluto\npluto pippo\npluto a \"b\"\n");
+    graph.writeDot(dot);
+    assert(dot.str().find("  2 [label=\"a \\\"b\\\"\"];\n") != std::string::npos);
+    assert(dot.str().find("  1 -> 2;\n") != std::string::npos);
+    graph.writeCompressed(compressed);
+    const char expected[] = { 3, 3, 1, 1, 2, 0, 1, 0 };
+    assert(compressed.str() == std::string(expected, sizeof(expected)));
+    
+    // Patch con nodi di stringhe contenenti spazi
+    graphString other(graph);
+    other.removeNode("pippo");
+    other.addNode("nuovo nodo");
+    other.addEdge("nuovo nodo", "a \"b\"");
+    std::ostringstream wire;
+    graphString::writePatch(graph.diff(other), wire);
+    std::istringstream in(wire.str());
+    graphString copy(graph);
+    copy.applyPatch(graphString::readPatch(in));
+    assert(copy.diff(other).empty() && other.diff(copy).empty());
+    
+    // Un intero non diventa implicitamente una destinazione di output
+    static_assert(!std::is_convertible<int, graph_output>::value, "conversione implicita da int");
+    
+#ifdef GRAPH_FD_OUTPUT
+    // Scrittura su file descriptor
+    FILE *f = std::tmpfile();
+    graph.writeMatrix(graph_output(fileno(f)));
+    std::rewind(f);
+    char buf[64] = { 0 };
+    size_t len = std::fread(buf, 1, sizeof(buf) - 1, f);
+    std::fclose(f);
+    assert(std::string(buf, len) == matrix.str());
+#endif
+}
+
+/**
+ Test del grafo di stringhe internate con attributi per colonne
+ 
+ @brief Test del grafo internato
+ */
+void test_internato_stringhe() {
+    std::cout<<"******** Test grafo internato di stringhe ********"<<std::endl;
+    
+    InternedGraph<std::string, equal_string> graph;
+    node_column<int> &peso = graph.addColumn<int>(1);
+    
+    try {
+        graph.addNode("pippo");
+        graph.addNode("pluto");
+        graph.addNode("paperino");
+        graph.addEdge("pippo", "pluto");
+        graph.addEdge("paperino", "pippo");
+    } catch (customException &m) {
+        std::cout << m.get_value() << " " << m.get_error() << std::endl;
+        return;
+    }
+    assert(graph.num_nodes() == 3 && graph.num_edges() == 2);
+    assert(graph.hasEdge("pippo", "pluto") && !graph.hasEdge("pluto", "pippo"));
+    
+    int pluto = graph.id("pluto");
+    assert(graph.key(pluto) == "pluto");
+    assert(peso[pluto] == 1);
+    peso[pluto] = 5;
+    
+    // Gli algoritmi lavorano sugli identificatori
+    assert(graph.structure().inDegree(pluto) == 1);
+    
+    graph.removeNode("pippo");
+    assert(!graph.exists("pippo"));
+    assert(graph.num_edges() == 0);
+    // paperino prende l'identificatore di pippo, con archi e attributi
+    assert(graph.id("paperino") == 0 && peso[pluto] == 5);
+    int cip = graph.addNode("cip");
+    assert(cip == 2 && graph.id_capacity() == 3 && peso[cip] == 1);
+    
+    // Rimozione e reinserimento: la posizione in structure() resta l'identificatore
+    graph.addEdge("cip", "pluto");
+    peso[cip] = 7;
+    graph.removeNode("paperino");
+    graph.addNode("qui");
+    graph.addEdge("qui", "cip");
+    std::vector<int> order(graph.structure().begin(), graph.structure().end());
+    for (unsigned int i = 0; i < order.size(); i++)
+        assert(order[i] == (int)i);
+    assert(graph.id("cip") == 0 && peso.data()[0] == 7 && peso.size() == 3);
+    assert(graph.hasEdge("cip", "pluto") && graph.hasEdge("qui", "cip"));
+    assert(graph.structure().inDegree(0) == 1 && graph.structure().outDegree(0) == 1);
+    graph.removeEdge("qui", "cip");
+    
+    InternedGraph<std::string, equal_string> copy(graph);
+    graph.removeNode("pluto");
+    assert(copy.exists("pluto") && copy.num_nodes() == 3);
+    
+    // Molte chiavi: la tabella hash deve crescere
+    for (int i = 0; i < 100; i++)
+        copy.addNode("n" + std::to_string(i));
+    for (int i = 0; i < 100; i += 2)
+        copy.removeNode("n" + std::to_string(i));
+    for (int i = 0; i < 100; i++)
+        assert(copy.exists("n" + std::to_string(i)) == (i % 2 == 1));
+    assert(copy.num_nodes() == 53 && copy.id_capacity() == 53);
+    std::vector<int> dense(copy.structure().begin(), copy.structure().end());
+    for (unsigned int i = 0; i < dense.size(); i++)
+        assert(dense[i] == (int)i && copy.id(copy.key(i)) == (int)i);
+    
+    try {
+        graph.addNode("cip");
+    } catch (customException &m) {
+        std::cout << m.get_value() << " " << m.get_error() << std::endl;
+    }
+}
+
 //--------------------------------------------------------------------
 
 /**
@@ -545,11 +1772,47 @@ int main() {
     
     test_eccezioni_interi();
     
+    test_diff_patch_interi();
+    
+    test_pagerank_interi();
+    
+    test_gradi_interi();
+    
+    test_vista_interi();
+    
+    test_trasposto_interi();
+    
+    test_statistiche_interi();
+    
+    test_riordinamento_interi();
+    
+    test_parallelo_interi();
+    
+    test_triangoli_interi();
+    
+    test_algebra_interi();
+    
+    test_colorazione_interi();
+    
+    test_esecutore_interi();
+    
+    test_multigrafo_interi();
+    
+    test_versionato_interi();
+    
+#ifdef GRAPH_PARTITIONED
+    test_partizionato_interi();
+#endif
+    
     test_metodi_fondamentali_stringhe();
     
     test_uso_stringhe();
     
     test_eccezioni_stringhe();
+    
+    test_esportazione_stringhe();
+    
+    test_internato_stringhe();
    
     test_metodi_fondamentali_point();
     